@@ -0,0 +1,61 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#ifndef PF_COMMON_BENCHMARKS_BENCHMARK_H
+#define PF_COMMON_BENCHMARKS_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <pf_common/macros.h>
+#include <thread>
+#include <vector>
+
+namespace pf::bench {
+
+/**
+ * Run callable several times and return the best wall time in seconds.
+ * @param callable measured code
+ * @param repetitions how many times the measurement is repeated
+ * @return best time in seconds
+ */
+inline double measure(std::invocable auto &&callable, std::size_t repetitions = 5) {
+  auto best = std::chrono::duration<double>::max();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    callable();
+    best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+  }
+  return best.count();
+}
+
+/**
+ * Thread counts 1, 2, 4, ... up to hardware concurrency (included).
+ */
+inline std::vector<std::size_t> threadCounts() {
+  const auto maxThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  auto result = std::vector<std::size_t>{};
+  for (std::size_t count = 1; count < maxThreads; count *= 2) { result.emplace_back(count); }
+  result.emplace_back(maxThreads);
+  return result;
+}
+
+/**
+ * Prevent the compiler from optimizing away a computed value.
+ */
+template<typename T>
+inline void doNotOptimize(const T &value) {
+#if PF_MSVC
+  static const void *volatile sink;
+  sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+}// namespace pf::bench
+
+#endif//PF_COMMON_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,46 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <mutex>
+#include <pf_common/parallel/AdaptiveMutex.h>
+#include <pf_common/parallel/Safe.h>
+#include <pf_common/parallel/SpinMutex.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t OPERATIONS_PER_THREAD = 1'000'000;
+
+/**
+ * Threads increment a shared counter in a tight loop, so the critical section is as short as it gets.
+ * @return increments per second
+ */
+template<typename Mutex>
+double incrementThroughput(std::size_t threadCount) {
+  const auto seconds = bench::measure(
+      [&] {
+        Safe<std::size_t, Mutex> counter{0};
+        auto threads = std::vector<std::thread>{};
+        for (std::size_t i = 0; i < threadCount; ++i) {
+          threads.emplace_back([&] {
+            for (std::size_t j = 0; j < OPERATIONS_PER_THREAD; ++j) { ++*counter.writeAccess(); }
+          });
+        }
+        for (auto &thread : threads) { thread.join(); }
+        bench::doNotOptimize(*counter.readOnlyAccess());
+      },
+      3);
+  return static_cast<double>(OPERATIONS_PER_THREAD * threadCount) / seconds;
+}
+
+int main() {
+  std::printf("%-10s %24s %24s %24s\n", "threads", "mutex [ops/s]", "SpinMutex [ops/s]", "AdaptiveMutex [ops/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    std::printf("%-10zu %24.0f %24.0f %24.0f\n", threadCount, incrementThroughput<std::mutex>(threadCount),
+                incrementThroughput<SpinMutex>(threadCount), incrementThroughput<AdaptiveMutex>(threadCount));
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <pf_common/ObjectPool.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t OPERATION_COUNT = 1'000'000;
+constexpr static std::size_t LIVE_OBJECT_COUNT = 64;
+
+/**
+ * Typical pooled object - a message with a small payload.
+ */
+struct Message {
+  std::uint64_t id = 0;
+  std::array<std::byte, 120> payload{};
+};
+
+/**
+ * Each thread keeps LIVE_OBJECT_COUNT messages alive and replaces them one by one, so objects aren't reused immediately.
+ * @param acquire creates a message owner
+ */
+double run(std::size_t threadCount, auto &&acquire) {
+  return bench::measure([&] {
+    auto threads = std::vector<std::jthread>{};
+    for (std::size_t i = 0; i < threadCount; ++i) {
+      threads.emplace_back([&] {
+        auto live = std::vector<decltype(acquire())>(LIVE_OBJECT_COUNT);
+        for (std::size_t j = 0; j < OPERATION_COUNT; ++j) {
+          auto &slot = live[j % LIVE_OBJECT_COUNT];
+          slot = {};
+          slot = acquire();
+          slot->id = j;
+          bench::doNotOptimize(slot->id);
+        }
+      });
+    }
+  });
+}
+
+/**
+ * Owner of a message allocated by plain new/delete.
+ */
+struct RawMessage {
+  RawMessage() = default;
+  explicit RawMessage(Message *message) : message(message) {}
+  RawMessage(RawMessage &&other) noexcept : message(std::exchange(other.message, nullptr)) {}
+  RawMessage &operator=(RawMessage &&other) noexcept {
+    delete message;
+    message = std::exchange(other.message, nullptr);
+    return *this;
+  }
+  ~RawMessage() { delete message; }
+  Message *operator->() const { return message; }
+  Message *message = nullptr;
+};
+
+int main() {
+  constexpr static std::size_t MAX_OBJECTS = 1 << 16;
+  ObjectPool<Message, MAX_OBJECTS, PoolAllocStrategy::IncreaseBy2x> pool{};
+  ObjectPool<Message, MAX_OBJECTS, PoolAllocStrategy::IncreaseBy2x, true> cachedPool{};
+
+  std::printf("%-8s %18s %18s %18s %18s\n", "threads", "new/delete", "make_unique", "ObjectPool", "ObjectPool+cache");
+  std::printf("%-8s %18s %18s %18s %18s\n", "", "[Mops/s]", "[Mops/s]", "[Mops/s]", "[Mops/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto operations = static_cast<double>(threadCount * OPERATION_COUNT) / 1e6;
+    const auto newDelete = run(threadCount, [] { return RawMessage{new Message{}}; });
+    const auto makeUnique = run(threadCount, [] { return std::make_unique<Message>(); });
+    const auto pooled = run(threadCount, [&] { return pool.lease(); });
+    const auto cached = run(threadCount, [&] { return cachedPool.lease(); });
+    std::printf("%-8zu %18.2f %18.2f %18.2f %18.2f\n", threadCount, operations / newDelete, operations / makeUnique, operations / pooled,
+                operations / cached);
+  }
+  return 0;
+}
@@ -0,0 +1,49 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <cmath>
+#include <numeric>
+#include <pf_common/parallel/algorithms.h>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t ELEMENT_COUNT = 1 << 24;
+
+float work(float value) { return std::sqrt(value) * std::sin(value); }
+
+int main() {
+  auto input = std::vector<float>(ELEMENT_COUNT);
+  std::iota(input.begin(), input.end(), 0.f);
+  auto output = std::vector<float>(ELEMENT_COUNT);
+
+  const auto serialFor = bench::measure([&] {
+    for (std::size_t i = 0; i < ELEMENT_COUNT; ++i) { output[i] = work(input[i]); }
+    bench::doNotOptimize(output.data());
+  });
+  const auto serialReduce = bench::measure([&] { bench::doNotOptimize(std::accumulate(input.begin(), input.end(), 0.0)); });
+  const auto serialTransform = bench::measure([&] {
+    std::ranges::transform(input, output.begin(), work);
+    bench::doNotOptimize(output.data());
+  });
+  std::printf("%-10s %16s %16s %16s\n", "threads", "for [ms]", "reduce [ms]", "transform [ms]");
+  std::printf("%-10s %16.2f %16.2f %16.2f\n", "serial", serialFor * 1000, serialReduce * 1000, serialTransform * 1000);
+
+  for (const auto threadCount : bench::threadCounts()) {
+    ThreadPool pool{threadCount};
+    const auto parallelForTime = bench::measure([&] {
+      parallelFor(pool, std::views::iota(std::size_t{0}, ELEMENT_COUNT), [&](std::size_t i) { output[i] = work(input[i]); });
+      bench::doNotOptimize(output.data());
+    });
+    const auto parallelReduceTime = bench::measure([&] { bench::doNotOptimize(parallelReduce(pool, input, 0.0)); });
+    const auto parallelTransformTime = bench::measure([&] {
+      parallelTransform(pool, input, output, work);
+      bench::doNotOptimize(output.data());
+    });
+    std::printf("%-10zu %16.2f %16.2f %16.2f\n", threadCount, parallelForTime * 1000, parallelReduceTime * 1000,
+                parallelTransformTime * 1000);
+  }
+  return 0;
+}
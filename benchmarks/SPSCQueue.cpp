@@ -0,0 +1,109 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <array>
+#include <pf_common/parallel/SPSCQueue.h>
+#include <pf_common/parallel/SafeQueue.h>
+
+using namespace pf;
+
+constexpr static std::size_t TOTAL_BYTES = 256ull * 1024 * 1024;
+constexpr static std::size_t BATCH_SIZE = 64;
+
+template<std::size_t Size>
+struct Payload {
+  std::array<std::byte, Size> data;
+};
+
+template<std::size_t Size>
+double safeQueue(std::size_t itemCount) {
+  return bench::measure(
+      [&] {
+        SafeQueue<Payload<Size>> queue{};
+        auto producer = std::thread{[&] {
+          for (std::size_t i = 0; i < itemCount; ++i) { queue.enqueue(Payload<Size>{}); }
+        }};
+        for (std::size_t i = 0; i < itemCount; ++i) { bench::doNotOptimize(queue.dequeue()); }
+        producer.join();
+      },
+      3);
+}
+
+template<std::size_t Size>
+double safeQueueBatch(std::size_t itemCount) {
+  return bench::measure(
+      [&] {
+        SafeQueue<Payload<Size>> queue{};
+        auto producer = std::thread{[&] {
+          auto batch = std::array<Payload<Size>, BATCH_SIZE>{};
+          for (std::size_t sent = 0; sent < itemCount; sent += BATCH_SIZE) {
+            queue.enqueueRange(std::span{batch}.first(std::min(BATCH_SIZE, itemCount - sent)));
+          }
+        }};
+        auto batch = std::array<Payload<Size>, BATCH_SIZE>{};
+        for (std::size_t received = 0; received < itemCount;) {
+          received += queue.dequeueBatch(batch);
+          bench::doNotOptimize(batch);
+        }
+        producer.join();
+      },
+      3);
+}
+
+template<std::size_t Size>
+double spscQueue(std::size_t itemCount) {
+  return bench::measure(
+      [&] {
+        SPSCQueue<Payload<Size>> queue{};
+        auto producer = std::thread{[&] {
+          for (std::size_t i = 0; i < itemCount; ++i) { queue.enqueue(Payload<Size>{}); }
+        }};
+        for (std::size_t i = 0; i < itemCount; ++i) { bench::doNotOptimize(queue.dequeue()); }
+        producer.join();
+      },
+      3);
+}
+
+template<std::size_t Size>
+double spscQueueBatch(std::size_t itemCount) {
+  return bench::measure(
+      [&] {
+        SPSCQueue<Payload<Size>> queue{};
+        auto producer = std::thread{[&] {
+          const auto batch = std::array<Payload<Size>, BATCH_SIZE>{};
+          for (std::size_t sent = 0; sent < itemCount;) {
+            const auto count = queue.tryEnqueueBatch(std::span{batch}.first(std::min(BATCH_SIZE, itemCount - sent)));
+            if (count == 0) { std::this_thread::yield(); }
+            sent += count;
+          }
+        }};
+        auto batch = std::array<Payload<Size>, BATCH_SIZE>{};
+        for (std::size_t received = 0; received < itemCount;) {
+          const auto count = queue.tryDequeueBatch(batch);
+          if (count == 0) { std::this_thread::yield(); }
+          received += count;
+          bench::doNotOptimize(batch);
+        }
+        producer.join();
+      },
+      3);
+}
+
+template<std::size_t Size>
+void run() {
+  const auto itemCount = TOTAL_BYTES / Size / (Size > 64 ? 1 : 8);
+  const auto toMBs = [&](double seconds) { return static_cast<double>(itemCount * Size) / seconds / (1024 * 1024); };
+  std::printf("%-10zu %18.1f %18.1f %18.1f %18.1f\n", Size, toMBs(safeQueue<Size>(itemCount)), toMBs(safeQueueBatch<Size>(itemCount)),
+              toMBs(spscQueue<Size>(itemCount)), toMBs(spscQueueBatch<Size>(itemCount)));
+}
+
+int main() {
+  std::printf("%-10s %18s %18s %18s %18s\n", "payload", "SafeQueue [MB/s]", "Safe batch [MB/s]", "SPSCQueue [MB/s]",
+              "SPSC batch [MB/s]");
+  run<8>();
+  run<64>();
+  run<1024>();
+  return 0;
+}
@@ -0,0 +1,59 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <pf_common/parallel/Safe.h>
+#include <pf_common/parallel/SeqLock.h>
+#include <shared_mutex>
+
+using namespace pf;
+
+constexpr static std::size_t READS_PER_THREAD = 1'000'000;
+constexpr static auto WRITE_PERIOD = std::chrono::microseconds{100};
+
+struct Config {
+  std::array<int, 8> values;
+};
+
+/**
+ * Reader threads read the value in a loop while one writer updates it periodically.
+ * @return reads per second
+ */
+template<typename Mutex>
+double readThroughput(std::size_t readerCount) {
+  const auto seconds = bench::measure(
+      [&] {
+        Safe<Config, Mutex> safe{Config{}};
+        std::atomic<bool> stop = false;
+        auto writer = std::thread{[&] {
+          for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            safe.writeAccess()->values.fill(i);
+            std::this_thread::sleep_for(WRITE_PERIOD);
+          }
+        }};
+        auto readers = std::vector<std::thread>{};
+        for (std::size_t i = 0; i < readerCount; ++i) {
+          readers.emplace_back([&] {
+            for (std::size_t j = 0; j < READS_PER_THREAD; ++j) { bench::doNotOptimize(safe.readOnlyAccess()->values[3]); }
+          });
+        }
+        for (auto &reader : readers) { reader.join(); }
+        stop = true;
+        writer.join();
+      },
+      3);
+  return static_cast<double>(READS_PER_THREAD * readerCount) / seconds;
+}
+
+int main() {
+  std::printf("%-10s %24s %24s %24s\n", "readers", "mutex [reads/s]", "shared_mutex [reads/s]", "SeqLock [reads/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    std::printf("%-10zu %24.0f %24.0f %24.0f\n", threadCount, readThroughput<std::mutex>(threadCount),
+                readThroughput<std::shared_mutex>(threadCount), readThroughput<SeqLock>(threadCount));
+  }
+  return 0;
+}
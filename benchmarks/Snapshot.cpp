@@ -0,0 +1,81 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <atomic>
+#include <pf_common/parallel/Safe.h>
+#include <pf_common/parallel/Snapshot.h>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace pf;
+
+constexpr static std::size_t LOOKUPS_PER_THREAD = 1'000'000;
+constexpr static int KEY_COUNT = 1024;
+constexpr static auto WRITE_PERIOD = std::chrono::microseconds{500};
+
+using Table = std::unordered_map<int, int>;
+
+Table makeTable() {
+  auto table = Table{};
+  for (int i = 0; i < KEY_COUNT; ++i) { table[i] = i; }
+  return table;
+}
+
+/**
+ * Reader threads look up keys in a loop while one writer periodically modifies the table.
+ * @param lookup (state, key) -> value
+ * @param write (state, iteration)
+ * @return lookups per second
+ */
+template<typename State>
+double lookupThroughput(std::size_t readerCount, auto lookup, auto write) {
+  const auto seconds = bench::measure(
+      [&] {
+        State state{makeTable()};
+        std::atomic<bool> stop = false;
+        auto writer = std::thread{[&] {
+          for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            write(state, i);
+            std::this_thread::sleep_for(WRITE_PERIOD);
+          }
+        }};
+        auto readers = std::vector<std::thread>{};
+        for (std::size_t i = 0; i < readerCount; ++i) {
+          readers.emplace_back([&] { lookup(state); });
+        }
+        for (auto &reader : readers) { reader.join(); }
+        stop = true;
+        writer.join();
+      },
+      3);
+  return static_cast<double>(LOOKUPS_PER_THREAD * readerCount) / seconds;
+}
+
+int main() {
+  std::printf("%-10s %24s %24s %24s\n", "readers", "Safe<shared> [lookups/s]", "load() [lookups/s]", "Reader [lookups/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto safe = lookupThroughput<Safe<Table, std::shared_mutex>>(
+        threadCount,
+        [](const auto &state) {
+          for (std::size_t i = 0; i < LOOKUPS_PER_THREAD; ++i) { bench::doNotOptimize(state.readOnlyAccess()->at(i % KEY_COUNT)); }
+        },
+        [](auto &state, int i) { state.writeAccess()->at(i % KEY_COUNT) = i; });
+    const auto load = lookupThroughput<Snapshot<Table>>(
+        threadCount,
+        [](const auto &state) {
+          for (std::size_t i = 0; i < LOOKUPS_PER_THREAD; ++i) { bench::doNotOptimize(state.load()->at(i % KEY_COUNT)); }
+        },
+        [](auto &state, int i) { state.update([i](Table &table) { table.at(i % KEY_COUNT) = i; }); });
+    const auto reader = lookupThroughput<Snapshot<Table>>(
+        threadCount,
+        [](const auto &state) {
+          auto reader = state.reader();
+          for (std::size_t i = 0; i < LOOKUPS_PER_THREAD; ++i) { bench::doNotOptimize(reader->at(i % KEY_COUNT)); }
+        },
+        [](auto &state, int i) { state.update([i](Table &table) { table.at(i % KEY_COUNT) = i; }); });
+    std::printf("%-10zu %24.0f %24.0f %24.0f\n", threadCount, safe, load, reader);
+  }
+  return 0;
+}
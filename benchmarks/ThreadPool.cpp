@@ -0,0 +1,131 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <atomic>
+#include <pf_common/parallel/ThreadPool.h>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t TASK_COUNT = 200'000;
+constexpr static std::size_t FAN_OUT = 64;
+
+/**
+ * Tasks submitted from a single external thread.
+ */
+double externalSubmission(std::size_t threadCount, ThreadPoolMode mode) {
+  return bench::measure(
+      [&] {
+        std::atomic<std::size_t> counter = 0;
+        {
+          ThreadPool pool{threadCount, mode};
+          for (std::size_t i = 0; i < TASK_COUNT; ++i) {
+            pool.enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+          }
+        }
+        bench::doNotOptimize(counter.load());
+      },
+      3);
+}
+
+/**
+ * Tasks submitted from inside of other tasks - each root task spawns FAN_OUT children.
+ */
+double nestedSubmission(std::size_t threadCount, ThreadPoolMode mode) {
+  return bench::measure(
+      [&] {
+        std::atomic<std::size_t> counter = 0;
+        {
+          ThreadPool pool{threadCount, mode};
+          for (std::size_t i = 0; i < TASK_COUNT / FAN_OUT; ++i) {
+            pool.enqueue([&pool, &counter] {
+              for (std::size_t j = 0; j < FAN_OUT; ++j) {
+                pool.enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+              }
+            });
+          }
+        }
+        bench::doNotOptimize(counter.load());
+      },
+      3);
+}
+
+enum class SubmissionApi { Enqueue, Post, PostBulk };
+
+/**
+ * Tasks submitted from a single external thread through different submission APIs.
+ */
+double submissionApi(std::size_t threadCount, SubmissionApi api) {
+  return bench::measure(
+      [&] {
+        std::atomic<std::size_t> counter = 0;
+        const auto task = [&counter] { counter.fetch_add(1, std::memory_order_relaxed); };
+        {
+          ThreadPool pool{threadCount};
+          switch (api) {
+            case SubmissionApi::Enqueue:
+              for (std::size_t i = 0; i < TASK_COUNT; ++i) { pool.enqueue(task); }
+              break;
+            case SubmissionApi::Post:
+              for (std::size_t i = 0; i < TASK_COUNT; ++i) { pool.post(task); }
+              break;
+            case SubmissionApi::PostBulk: {
+              const auto batch = std::vector(FAN_OUT, task);
+              for (std::size_t i = 0; i < TASK_COUNT / FAN_OUT; ++i) { pool.postBulk(batch); }
+              break;
+            }
+          }
+        }
+        bench::doNotOptimize(counter.load());
+      },
+      3);
+}
+
+/**
+ * Tasks posted from a single external thread with statistics disabled or enabled.
+ */
+double statsOverhead(std::size_t threadCount, bool statsEnabled) {
+  return bench::measure(
+      [&] {
+        std::atomic<std::size_t> counter = 0;
+        {
+          ThreadPool pool{threadCount};
+          if (statsEnabled) { pool.enableStats(); }
+          for (std::size_t i = 0; i < TASK_COUNT; ++i) {
+            pool.post([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+          }
+        }
+        bench::doNotOptimize(counter.load());
+      },
+      3);
+}
+
+int main() {
+  std::printf("%-10s %-10s %20s %20s\n", "scenario", "threads", "shared [tasks/s]", "stealing [tasks/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto shared = externalSubmission(threadCount, ThreadPoolMode::SharedQueue);
+    const auto stealing = externalSubmission(threadCount, ThreadPoolMode::WorkStealing);
+    std::printf("%-10s %-10zu %20.0f %20.0f\n", "external", threadCount, TASK_COUNT / shared, TASK_COUNT / stealing);
+  }
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto shared = nestedSubmission(threadCount, ThreadPoolMode::SharedQueue);
+    const auto stealing = nestedSubmission(threadCount, ThreadPoolMode::WorkStealing);
+    std::printf("%-10s %-10zu %20.0f %20.0f\n", "nested", threadCount, TASK_COUNT / shared, TASK_COUNT / stealing);
+  }
+  std::printf("\n%-10s %20s %20s %20s\n", "threads", "enqueue [tasks/s]", "post [tasks/s]", "postBulk [tasks/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto enqueue = submissionApi(threadCount, SubmissionApi::Enqueue);
+    const auto post = submissionApi(threadCount, SubmissionApi::Post);
+    const auto postBulk = submissionApi(threadCount, SubmissionApi::PostBulk);
+    std::printf("%-10zu %20.0f %20.0f %20.0f\n", threadCount, TASK_COUNT / enqueue, TASK_COUNT / post, TASK_COUNT / postBulk);
+  }
+  std::printf("\n%-10s %20s %20s\n", "threads", "no stats [tasks/s]", "stats [tasks/s]");
+  for (const auto threadCount : bench::threadCounts()) {
+    const auto disabled = statsOverhead(threadCount, false);
+    const auto enabled = statsOverhead(threadCount, true);
+    std::printf("%-10zu %20.0f %20.0f\n", threadCount, TASK_COUNT / disabled, TASK_COUNT / enabled);
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <pf_common/parallel/ThreadPool.h>
+#include <pf_common/parallel/TimerWheel.h>
+#include <random>
+#include <vector>
+
+using namespace pf;
+using namespace std::chrono_literals;
+
+constexpr static std::size_t TIMER_COUNT = 500'000;
+
+/**
+ * Deadlines spread over a minute so timers end up in all levels of the wheel.
+ */
+std::vector<std::chrono::steady_clock::duration> makeDelays() {
+  auto random = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<std::int64_t>{1, 60'000};
+  auto result = std::vector<std::chrono::steady_clock::duration>(TIMER_COUNT);
+  for (auto &delay : result) { delay = std::chrono::milliseconds{distribution(random)}; }
+  return result;
+}
+
+/**
+ * Schedule TIMER_COUNT timers and cancel all of them.
+ */
+double timerWheel(const std::vector<std::chrono::steady_clock::duration> &delays) {
+  ThreadPool pool{1};
+  TimerWheel wheel{pool};
+  auto handles = std::vector<TimerHandle>(TIMER_COUNT);
+  return bench::measure([&] {
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < TIMER_COUNT; ++i) { handles[i] = wheel.scheduleAt(now + delays[i], [] {}); }
+    for (const auto handle : handles) { wheel.cancel(handle); }
+    bench::doNotOptimize(handles.data());
+  });
+}
+
+/**
+ * The same with an ordered map guarded by a mutex, the usual alternative with O(log n) operations.
+ */
+double orderedMap(const std::vector<std::chrono::steady_clock::duration> &delays) {
+  using Timers = std::multimap<std::chrono::steady_clock::time_point, std::function<void()>>;
+  auto mutex = std::mutex{};
+  auto timers = Timers{};
+  auto handles = std::vector<Timers::iterator>(TIMER_COUNT);
+  return bench::measure([&] {
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < TIMER_COUNT; ++i) {
+      std::lock_guard lock{mutex};
+      handles[i] = timers.emplace(now + delays[i], [] {});
+    }
+    for (const auto handle : handles) {
+      std::lock_guard lock{mutex};
+      timers.erase(handle);
+    }
+    bench::doNotOptimize(timers.size());
+  });
+}
+
+int main() {
+  const auto delays = makeDelays();
+  const auto wheel = timerWheel(delays);
+  const auto map = orderedMap(delays);
+  std::printf("%-20s %25s\n", "scheduler", "schedule+cancel [ops/s]");
+  std::printf("%-20s %25.0f\n", "TimerWheel", TIMER_COUNT / wheel);
+  std::printf("%-20s %25.0f\n", "std::multimap", TIMER_COUNT / map);
+  return 0;
+}
@@ -0,0 +1,111 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <cstdint>
+#include <optional>
+#include <pf_common/containers/ArenaTree.h>
+#include <pf_common/containers/FrozenTree.h>
+#include <pf_common/containers/Tree.h>
+#include <random>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t NODE_COUNT = 1'000'000;
+constexpr static std::size_t SMALL_TREE_COUNT = 100'000;
+constexpr static std::size_t SMALL_TREE_SIZE = 10;
+
+/**
+ * Parent of each node, parents are picked among recently added nodes so the tree is both wide and deep.
+ */
+std::vector<std::size_t> makeParents() {
+  auto random = std::mt19937{42};
+  auto result = std::vector<std::size_t>(NODE_COUNT);
+  for (std::size_t i = 1; i < NODE_COUNT; ++i) {
+    result[i] = std::uniform_int_distribution<std::size_t>{i > 64 ? i - 64 : 0, i - 1}(random);
+  }
+  return result;
+}
+
+template<typename TreeType, typename NodeType>
+TreeType build(const std::vector<std::size_t> &parents) {
+  auto tree = TreeType{std::uint64_t{0}};
+  auto nodes = std::vector<NodeType *>{&tree.getRoot()};
+  nodes.reserve(parents.size());
+  for (std::size_t i = 1; i < parents.size(); ++i) { nodes.emplace_back(&nodes[parents[i]]->appendChild(std::uint64_t{i})); }
+  return tree;
+}
+
+template<typename TreeType>
+std::uint64_t sumDepthFirst(TreeType &tree) {
+  std::uint64_t sum = 0;
+  for (const auto value : tree.iterDepthFirst()) { sum += value; }
+  return sum;
+}
+
+template<typename TreeType>
+std::uint64_t sumBreadthFirst(TreeType &tree) {
+  std::uint64_t sum = 0;
+  for (const auto value : tree.iterBreadthFirst()) { sum += value; }
+  return sum;
+}
+
+template<typename TreeType>
+void traverse(const char *name, TreeType &tree) {
+  const auto depthFirstTime = bench::measure([&] { bench::doNotOptimize(sumDepthFirst(tree)); });
+  const auto breadthFirstTime = bench::measure([&] { bench::doNotOptimize(sumBreadthFirst(tree)); });
+  std::printf("%-12s %20.2f %20.2f\n", name, depthFirstTime * 1000, breadthFirstTime * 1000);
+}
+
+/**
+ * Many traversals of small trees, where the cost of setting up an iterator dominates.
+ */
+template<typename TreeType, typename NodeType>
+void traverseSmall(const char *name) {
+  auto parents = makeParents();
+  parents.resize(SMALL_TREE_SIZE);
+  auto trees = std::vector<TreeType>{};
+  trees.reserve(SMALL_TREE_COUNT);
+  for (std::size_t i = 0; i < SMALL_TREE_COUNT; ++i) { trees.emplace_back(build<TreeType, NodeType>(parents)); }
+  const auto depthFirstTime = bench::measure([&] {
+    for (auto &tree : trees) { bench::doNotOptimize(sumDepthFirst(tree)); }
+  });
+  const auto breadthFirstTime = bench::measure([&] {
+    for (auto &tree : trees) { bench::doNotOptimize(sumBreadthFirst(tree)); }
+  });
+  std::printf("%-12s %20.2f %20.2f\n", name, depthFirstTime * 1000, breadthFirstTime * 1000);
+}
+
+template<typename TreeType, typename NodeType>
+void run(const char *name, const std::vector<std::size_t> &parents) {
+  const auto buildTime = bench::measure([&] { bench::doNotOptimize(build<TreeType, NodeType>(parents).hasRoot()); });
+  auto tree = std::optional{build<TreeType, NodeType>(parents)};
+  const auto traversalTime = bench::measure([&] { bench::doNotOptimize(sumDepthFirst(*tree)); });
+  const auto destroyTime = bench::measure([&] { tree.reset(); }, 1);
+  std::printf("%-12s %20.2f %20.2f %20.2f\n", name, buildTime * 1000, traversalTime * 1000, destroyTime * 1000);
+}
+
+int main() {
+  const auto parents = makeParents();
+  std::printf("%-12s %20s %20s %20s\n", "tree", "build [ms]", "depth first [ms]", "destroy [ms]");
+  run<Tree<std::uint64_t>, Node<std::uint64_t>>("Tree", parents);
+  run<ArenaTree<std::uint64_t>, ArenaNode<std::uint64_t>>("ArenaTree", parents);
+
+  auto tree = build<Tree<std::uint64_t>, Node<std::uint64_t>>(parents);
+  auto arenaTree = build<ArenaTree<std::uint64_t>, ArenaNode<std::uint64_t>>(parents);
+  const auto freezeTime = bench::measure([&] { bench::doNotOptimize(freeze(tree).size()); });
+  auto frozenTree = freeze(tree);
+  std::printf("\nfreeze [ms] %.2f\n", freezeTime * 1000);
+  std::printf("%-12s %20s %20s\n", "tree", "depth first [ms]", "breadth first [ms]");
+  traverse("Tree", tree);
+  traverse("ArenaTree", arenaTree);
+  traverse("FrozenTree", frozenTree);
+
+  std::printf("\n%zu trees of %zu nodes\n", SMALL_TREE_COUNT, SMALL_TREE_SIZE);
+  std::printf("%-12s %20s %20s\n", "tree", "depth first [ms]", "breadth first [ms]");
+  traverseSmall<Tree<std::uint64_t>, Node<std::uint64_t>>("Tree");
+  traverseSmall<ArenaTree<std::uint64_t>, ArenaNode<std::uint64_t>>("ArenaTree");
+  return 0;
+}
@@ -0,0 +1,62 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include <cmath>
+#include <numeric>
+#include <pf_common/parallel/TreeAlgorithms.h>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace pf;
+
+constexpr static std::size_t NODE_COUNT = 500'000;
+
+float work(float value) {
+  for (int i = 0; i < 16; ++i) { value = std::sqrt(value) * std::sin(value) + 1.f; }
+  return value;
+}
+
+Tree<float> makeTree() {
+  auto tree = Tree<float>{0.f};
+  auto nodes = std::vector<Node<float> *>{&tree.getRoot()};
+  auto random = std::mt19937{42};
+  for (std::size_t i = 1; i < NODE_COUNT; ++i) {
+    auto parentIndex = std::uniform_int_distribution<std::size_t>{nodes.size() > 64 ? nodes.size() - 64 : 0, nodes.size() - 1};
+    nodes.emplace_back(&nodes[parentIndex(random)]->appendChild(static_cast<float>(i)));
+  }
+  return tree;
+}
+
+float serialFold(const Node<float> &node) {
+  auto result = work(*node);
+  for (const auto &child : node.children()) { result += serialFold(child); }
+  return result;
+}
+
+int main() {
+  auto tree = makeTree();
+  const auto fold = [](const Node<float> &node, std::span<float> children) {
+    return std::accumulate(children.begin(), children.end(), work(*node));
+  };
+
+  const auto serialVisit = bench::measure([&] {
+    tree_traversal::depthFirst(tree, [](Node<float> &node) { bench::doNotOptimize(work(*node)); });
+  });
+  const auto serialFoldTime = bench::measure([&] { bench::doNotOptimize(serialFold(tree.getRoot())); });
+  std::printf("%-10s %20s %20s\n", "threads", "depth first [ms]", "post order fold [ms]");
+  std::printf("%-10s %20.2f %20.2f\n", "serial", serialVisit * 1000, serialFoldTime * 1000);
+
+  for (const auto threadCount : bench::threadCounts()) {
+    ThreadPool pool{threadCount};
+    const auto parallelVisit = bench::measure([&] {
+      parallelDepthFirst(pool, tree, [](Node<float> &node) { bench::doNotOptimize(work(*node)); });
+    });
+    const auto parallelFold = bench::measure([&] { bench::doNotOptimize(parallelFoldPostOrder<float>(pool, std::as_const(tree), fold)); });
+    std::printf("%-10zu %20.2f %20.2f\n", threadCount, parallelVisit * 1000, parallelFold * 1000);
+  }
+  return 0;
+}
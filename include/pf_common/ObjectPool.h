@@ -0,0 +1,391 @@
+/**
+ * @file ObjectPool.h
+ * @brief Object pool for object leasing.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_OBJECT_POOL_H
+#define PF_COMMON_OBJECT_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <pf_common/parallel/SpinMutex.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pf {
+
+/**
+ * @brief Allocation strategy for ObjectPool.
+ */
+enum class PoolAllocStrategy {
+  Preallocate, ///< all objects are created with the pool
+  IncreaseBy2x,///< capacity doubles when the pool runs out of objects
+  OnDemand     ///< objects are created one by one when the pool runs out of them
+};
+
+namespace details {
+/**
+ * @return how many objects a pool with the strategy creates when it runs out of them
+ */
+template<PoolAllocStrategy Strategy>
+[[nodiscard]] constexpr std::size_t poolGrowthSize(std::size_t capacity, std::size_t maxCapacity) {
+  if constexpr (Strategy == PoolAllocStrategy::Preallocate) {
+    return capacity == 0 ? maxCapacity : 0;
+  } else if constexpr (Strategy == PoolAllocStrategy::IncreaseBy2x) {
+    return std::min(std::max<std::size_t>(capacity, 1), maxCapacity - capacity);
+  } else {
+    return capacity < maxCapacity ? 1 : 0;
+  }
+}
+
+/**
+ * @brief Storage of ObjectPool, shared with thread local caches which have to know whether the pool still exists.
+ *
+ * Objects live in slots allocated in blocks, free slots are linked into an intrusive list. Slots are never freed before the pool
+ * is destroyed, so leasing an object is just a pop from the list.
+ */
+template<typename T, PoolAllocStrategy Strategy>
+class ObjectPoolCore : public std::enable_shared_from_this<ObjectPoolCore<T, Strategy>> {
+ public:
+  struct Slot {
+    T value;
+    Slot *nextFree = nullptr;
+  };
+
+  ObjectPoolCore(std::function<T()> &&generator, std::size_t maxCapacity)
+      : generator(std::move(generator)), maxCapacity(maxCapacity) {
+    if constexpr (Strategy == PoolAllocStrategy::Preallocate) { grow(); }
+  }
+  ObjectPoolCore(const ObjectPoolCore &) = delete;
+  ObjectPoolCore &operator=(const ObjectPoolCore &) = delete;
+  ~ObjectPoolCore() {
+    for (const auto &[slots, size] : blocks) {
+      std::destroy_n(slots, size);
+      std::allocator<Slot>{}.deallocate(slots, size);
+    }
+  }
+
+  /**
+   * Move up to count free slots to the front of list, growing the pool if it has no free slot.
+   * @return how many slots were moved
+   */
+  std::size_t take(Slot *&list, std::size_t count) {
+    if (const auto taken = takeFree(list, count); taken != 0) { return taken; }
+    // only growth is serialized, other threads keep leasing and releasing while the generator runs
+    std::lock_guard lock{growMutex};
+    if (const auto taken = takeFree(list, count); taken != 0) { return taken; }
+    grow();
+    return takeFree(list, count);
+  }
+  /**
+   * Return a list of count slots ending with last.
+   */
+  void give(Slot *first, Slot *last, std::size_t count) {
+    std::lock_guard lock{mtx};
+    last->nextFree = freeHead;
+    freeHead = first;
+    freeCount += count;
+  }
+
+  [[nodiscard]] std::size_t capacity() const {
+    std::lock_guard lock{mtx};
+    return capacity_;
+  }
+  [[nodiscard]] std::size_t available() const {
+    std::lock_guard lock{mtx};
+    return freeCount;
+  }
+
+  /**
+   * Unique for every pool created during the program's run, unlike the address.
+   */
+  const std::uint64_t id = nextId();
+
+ private:
+  [[nodiscard]] static std::uint64_t nextId() {
+    static std::atomic<std::uint64_t> counter = 0;
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::size_t takeFree(Slot *&list, std::size_t count) {
+    std::lock_guard lock{mtx};
+    std::size_t taken = 0;
+    for (; taken < count && freeHead != nullptr; ++taken) {
+      auto slot = freeHead;
+      freeHead = slot->nextFree;
+      slot->nextFree = list;
+      list = slot;
+    }
+    freeCount -= taken;
+    return taken;
+  }
+
+  /**
+   * Create a new block of objects, caller holds growMutex. Objects are created outside of the spin lock.
+   */
+  void grow() {
+    const auto size = poolGrowthSize<Strategy>(capacity_, maxCapacity);
+    if (size == 0) { return; }
+    auto slots = std::allocator<Slot>{}.allocate(size);
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < size; ++constructed) { ::new (static_cast<void *>(slots + constructed)) Slot{generator(), nullptr}; }
+      for (std::size_t i = size - 1; i > 0; --i) { slots[i - 1].nextFree = slots + i; }
+      std::lock_guard lock{mtx};
+      blocks.emplace_back(slots, size);
+      slots[size - 1].nextFree = freeHead;
+      freeHead = slots;
+      capacity_ += size;
+      freeCount += size;
+    } catch (...) {
+      std::destroy_n(slots, constructed);
+      std::allocator<Slot>{}.deallocate(slots, size);
+      throw;
+    }
+  }
+
+  std::function<T()> generator;
+  std::size_t maxCapacity;
+  std::mutex growMutex;
+  mutable SpinMutex mtx;
+  std::vector<std::pair<Slot *, std::size_t>> blocks;
+  Slot *freeHead = nullptr;
+  std::size_t freeCount = 0;
+  std::size_t capacity_ = 0;
+};
+}// namespace details
+
+/**
+ * @brief Object pool to avoid multiple allocations and deallocations of objects. Thread-safe.
+ *
+ * Objects are created by a generator when the pool grows and are never destroyed before the pool. A leased object keeps its state
+ * from the previous lease, it is the user's responsibility to reset it if needed. Leased objects are accessed through RAII handles
+ * which return them to the pool. All handles have to be released before the pool is destroyed.
+ *
+ * With UseThreadCache each thread keeps its own list of free objects and exchanges them with the pool in batches, so leasing and
+ * releasing don't need any synchronization in the common case. Objects cached by a thread count as used for other threads, so
+ * a bounded pool may run out of objects while other threads still cache some of them. A thread's cache is returned to the pool
+ * when the thread exits.
+ * @tparam T type of pooled objects
+ * @tparam PoolSize maximum amount of objects
+ * @tparam Strategy how the pool grows
+ * @tparam UseThreadCache use per thread caches of free objects
+ */
+template<typename T, std::size_t PoolSize, PoolAllocStrategy Strategy = PoolAllocStrategy::Preallocate, bool UseThreadCache = false>
+class ObjectPool {
+  using Core = details::ObjectPoolCore<T, Strategy>;
+  using Slot = typename Core::Slot;
+
+ public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+
+  constexpr static size_type CACHE_BATCH_SIZE = 32;
+  constexpr static size_type MAX_CACHED_OBJECTS = CACHE_BATCH_SIZE * 4;
+
+  /**
+   * @brief Leased object, it is returned to the pool on destruction.
+   */
+  class Handle {
+    friend class ObjectPool;
+
+   public:
+    Handle() = default;
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+    Handle(Handle &&other) noexcept : core(std::exchange(other.core, nullptr)), slot(std::exchange(other.slot, nullptr)) {}
+    Handle &operator=(Handle &&other) noexcept {
+      if (this != &other) {
+        reset();
+        core = std::exchange(other.core, nullptr);
+        slot = std::exchange(other.slot, nullptr);
+      }
+      return *this;
+    }
+    ~Handle() { reset(); }
+
+    [[nodiscard]] reference operator*() const { return slot->value; }
+    [[nodiscard]] T *operator->() const { return &slot->value; }
+    [[nodiscard]] T *get() const { return slot == nullptr ? nullptr : &slot->value; }
+    [[nodiscard]] explicit operator bool() const { return slot != nullptr; }
+
+    /**
+     * Return the object to the pool.
+     */
+    void reset() {
+      if (slot == nullptr) { return; }
+      ObjectPool::release(*core, slot);
+      core = nullptr;
+      slot = nullptr;
+    }
+
+   private:
+    Handle(Core *core, Slot *slot) : core(core), slot(slot) {}
+
+    Core *core = nullptr;
+    Slot *slot = nullptr;
+  };
+
+  /**
+   * Construct ObjectPool with default constructed objects.
+   */
+  ObjectPool()
+    requires std::default_initializable<T>
+      : ObjectPool([] { return T(); }) {}
+
+  /**
+   * Construct ObjectPool with custom object creation.
+   * @param generator function creating the pool's objects
+   */
+  explicit ObjectPool(std::invocable auto &&generator)
+    requires(std::same_as<T, std::invoke_result_t<decltype(generator)>>)
+      : core(std::make_shared<Core>(std::forward<decltype(generator)>(generator), PoolSize)) {}
+
+  ObjectPool(ObjectPool &&) noexcept = default;
+  ObjectPool &operator=(ObjectPool &&) noexcept = default;
+
+  /**
+   * Lease an object from the pool, growing the pool if needed.
+   * @throws std::runtime_error when all PoolSize objects are leased
+   */
+  [[nodiscard]] Handle lease() {
+    auto result = tryLease();
+    if (!result) { throw std::runtime_error{"Pool has no available objects."}; }
+    return result;
+  }
+
+  /**
+   * Lease an object from the pool, growing the pool if needed.
+   * @return empty handle when all PoolSize objects are leased
+   */
+  [[nodiscard]] Handle tryLease() {
+    if constexpr (UseThreadCache) {
+      const auto caches = LocalCaches::get();
+      if (caches == nullptr) { return leaseShared(); }
+      auto &cache = caches->find(*core);
+      if (cache.head == nullptr) { cache.count += core->take(cache.head, CACHE_BATCH_SIZE); }
+      if (cache.head == nullptr) { return {}; }
+      auto slot = cache.head;
+      cache.head = slot->nextFree;
+      --cache.count;
+      return {core.get(), slot};
+    } else {
+      return leaseShared();
+    }
+  }
+
+  /**
+   * @return amount of created objects
+   */
+  [[nodiscard]] size_type capacity() const { return core->capacity(); }
+
+  /**
+   * @return amount of leased objects, including objects in threads' caches
+   */
+  [[nodiscard]] size_type used() const { return capacity() - available(); }
+
+  /**
+   * @return amount of objects available to all threads
+   */
+  [[nodiscard]] size_type available() const { return core->available(); }
+
+ private:
+  /**
+   * @brief Free objects of pools of this type cached by one thread.
+   */
+  class LocalCaches {
+   public:
+    struct Cache {
+      std::uint64_t poolId;
+      std::weak_ptr<Core> core;
+      Slot *head = nullptr;
+      size_type count = 0;
+    };
+
+    /**
+     * @return caches of the calling thread, nullptr once they were destroyed during the thread's exit
+     */
+    [[nodiscard]] static LocalCaches *get() {
+      if (destroyed) { return nullptr; }
+      thread_local LocalCaches instance{};
+      return &instance;
+    }
+
+    LocalCaches() = default;
+    LocalCaches(const LocalCaches &) = delete;
+    LocalCaches &operator=(const LocalCaches &) = delete;
+    ~LocalCaches() {
+      destroyed = true;
+      for (auto &cache : caches) {
+        if (auto owner = cache.core.lock(); owner != nullptr) { flush(*owner, cache, cache.count); }
+      }
+    }
+
+    [[nodiscard]] Cache &find(Core &owner) {
+      if (lastUsed < caches.size() && caches[lastUsed].poolId == owner.id) { return caches[lastUsed]; }
+      for (lastUsed = 0; lastUsed < caches.size(); ++lastUsed) {
+        if (caches[lastUsed].poolId == owner.id) { return caches[lastUsed]; }
+      }
+      // slots cached for destroyed pools are gone with them
+      std::erase_if(caches, [](const Cache &cache) { return cache.core.expired(); });
+      lastUsed = caches.size();
+      return caches.emplace_back(Cache{owner.id, owner.weak_from_this()});
+    }
+
+    /**
+     * Return the first count objects of the cache to its pool.
+     */
+    static void flush(Core &owner, Cache &cache, size_type count) {
+      if (count == 0) { return; }
+      auto first = cache.head;
+      auto last = cache.head;
+      for (size_type i = 1; i < count; ++i) { last = last->nextFree; }
+      cache.head = last->nextFree;
+      cache.count -= count;
+      owner.give(first, last, count);
+    }
+
+   private:
+    // trivially destructible, so it can be checked from destructors of other thread locals running after this one's
+    static inline thread_local bool destroyed = false;
+
+    std::vector<Cache> caches;
+    size_type lastUsed = 0;
+  };
+
+  [[nodiscard]] Handle leaseShared() {
+    Slot *slot = nullptr;
+    if (core->take(slot, 1) == 0) { return {}; }
+    return {core.get(), slot};
+  }
+
+  static void release(Core &owner, Slot *slot) {
+    if constexpr (UseThreadCache) {
+      // handles released by thread local destructors after the thread's caches are gone return objects to the pool directly
+      if (const auto caches = LocalCaches::get(); caches != nullptr) {
+        auto &cache = caches->find(owner);
+        slot->nextFree = cache.head;
+        cache.head = slot;
+        if (++cache.count > MAX_CACHED_OBJECTS) { LocalCaches::flush(owner, cache, CACHE_BATCH_SIZE); }
+        return;
+      }
+    }
+    owner.give(slot, slot, 1);
+  }
+
+  std::shared_ptr<Core> core;
+};
+}// namespace pf
+#endif//PF_COMMON_OBJECT_POOL_H
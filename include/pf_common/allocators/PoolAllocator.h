@@ -0,0 +1,196 @@
+/**
+ * @file PoolAllocator.h
+ * @brief Allocator recycling fixed size blocks through per thread free lists.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_ALLOCATORS_POOLALLOCATOR_H
+#define PF_COMMON_ALLOCATORS_POOLALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace pf {
+namespace details {
+/**
+ * @brief Free list of blocks of one size shared by all PoolAllocators with the same block size and alignment.
+ *
+ * Each thread keeps its own cache of free blocks, so allocation and deallocation don't need any synchronization in the common case.
+ * Blocks freed on a different thread than they were allocated on (e.g. a task's shared state released by a worker) are passed back
+ * through a global list in batches. The global allocator is only used when the pool is empty and blocks are never returned to it.
+ */
+template<std::size_t Size, std::size_t Alignment>
+class FixedSizeBlockPool {
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+ public:
+  constexpr static std::size_t BLOCK_SIZE = std::max(Size, sizeof(FreeBlock));
+  constexpr static std::size_t BLOCK_ALIGNMENT = std::max(Alignment, alignof(FreeBlock));
+  constexpr static std::size_t BATCH_SIZE = 64;
+  constexpr static std::size_t MAX_LOCAL_BLOCKS = BATCH_SIZE * 4;
+
+  [[nodiscard]] static void *allocate() {
+    auto cache = LocalCache::get();
+    if (cache == nullptr) { return allocateShared(); }
+    if (cache->head == nullptr) { cache->refill(); }
+    if (cache->head == nullptr) { return allocateNew(); }
+    auto block = cache->head;
+    cache->head = block->next;
+    --cache->count;
+    return block;
+  }
+
+  static void deallocate(void *ptr) noexcept {
+    auto cache = LocalCache::get();
+    if (cache == nullptr) {
+      deallocateShared(ptr);
+      return;
+    }
+    cache->head = std::construct_at(static_cast<FreeBlock *>(ptr), cache->head);
+    if (++cache->count > MAX_LOCAL_BLOCKS) { cache->release(BATCH_SIZE); }
+  }
+
+ private:
+  struct GlobalList {
+    // never destroyed so that blocks can be returned during static destruction
+    [[nodiscard]] static GlobalList &get() {
+      static auto instance = new GlobalList{};
+      return *instance;
+    }
+
+    std::mutex mtx;
+    FreeBlock *head = nullptr;
+  };
+
+  [[nodiscard]] static void *allocateNew() { return ::operator new(BLOCK_SIZE, std::align_val_t{BLOCK_ALIGNMENT}); }
+
+  // used once the thread's cache was destroyed, e.g. by destructors of other thread_local objects
+  [[nodiscard]] static void *allocateShared() {
+    auto &global = GlobalList::get();
+    {
+      std::lock_guard lock{global.mtx};
+      if (auto block = global.head; block != nullptr) {
+        global.head = block->next;
+        return block;
+      }
+    }
+    return allocateNew();
+  }
+
+  static void deallocateShared(void *ptr) noexcept {
+    auto &global = GlobalList::get();
+    std::lock_guard lock{global.mtx};
+    global.head = std::construct_at(static_cast<FreeBlock *>(ptr), global.head);
+  }
+
+  struct LocalCache {
+    /**
+     * @return cache of the calling thread or nullptr if it was already destroyed during thread exit
+     */
+    [[nodiscard]] static LocalCache *get() {
+      if (destroyed) { return nullptr; }
+      thread_local LocalCache instance{};
+      return &instance;
+    }
+
+    ~LocalCache() {
+      destroyed = true;
+      release(count);
+    }
+
+    void refill() {
+      auto &global = GlobalList::get();
+      std::lock_guard lock{global.mtx};
+      while (global.head != nullptr && count < BATCH_SIZE) {
+        auto block = global.head;
+        global.head = block->next;
+        block->next = head;
+        head = block;
+        ++count;
+      }
+    }
+
+    void release(std::size_t blockCount) {
+      if (blockCount == 0) { return; }
+      auto first = head;
+      auto last = head;
+      for (std::size_t i = 1; i < blockCount; ++i) { last = last->next; }
+      head = last->next;
+      count -= blockCount;
+      auto &global = GlobalList::get();
+      std::lock_guard lock{global.mtx};
+      last->next = global.head;
+      global.head = first;
+    }
+
+    FreeBlock *head = nullptr;
+    std::size_t count = 0;
+    // trivially destructible, so it stays valid for the whole thread exit
+    static inline thread_local bool destroyed = false;
+  };
+};
+}// namespace details
+
+/**
+ * @brief Stateless allocator for single objects, backed by a shared pool of fixed size blocks.
+ *
+ * Meant for objects which are frequently created and destroyed, possibly on different threads - e.g. shared states of std::promise.
+ * Allocations of more than one object are forwarded to std::allocator.
+ *
+ * Memory obtained by the pool is never returned to the system - freed blocks are only recycled for further allocations of the same
+ * block size for the rest of the program. Peak usage of each block size is therefore retained, so the allocator isn't suitable for
+ * one-off bursts of allocations. Objects may be deallocated at any point of the program, including destructors of thread_local
+ * objects and static destruction.
+ * @tparam T allocated type
+ */
+template<typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+  template<typename U>
+  struct rebind {
+    using other = PoolAllocator<U>;
+  };
+
+  constexpr PoolAllocator() noexcept = default;
+  template<typename U>
+  constexpr PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  [[nodiscard]] friend constexpr bool operator==(const PoolAllocator &, const PoolAllocator &) noexcept { return true; }
+  [[nodiscard]] friend constexpr bool operator!=(const PoolAllocator &, const PoolAllocator &) noexcept { return false; }
+
+  [[nodiscard]] pointer allocate(size_type n) {
+    if (n != 1) { return std::allocator<T>{}.allocate(n); }
+    return static_cast<pointer>(Pool::allocate());
+  }
+
+  void deallocate(pointer ptr, size_type n) noexcept {
+    if (n != 1) {
+      std::allocator<T>{}.deallocate(ptr, n);
+      return;
+    }
+    Pool::deallocate(ptr);
+  }
+
+ private:
+  using Pool = details::FixedSizeBlockPool<sizeof(T), alignof(T)>;
+};
+}// namespace pf
+
+#endif//PF_COMMON_ALLOCATORS_POOLALLOCATOR_H
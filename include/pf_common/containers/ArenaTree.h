@@ -0,0 +1,582 @@
+/**
+ * @file ArenaTree.h
+ * @brief Tree with a dynamic child count storing its nodes in contiguous blocks.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+#ifndef PF_COMMON_ARENATREE_H
+#define PF_COMMON_ARENATREE_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <pf_common/containers/Tree.h>
+#include <pf_common/macros.h>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pf {
+template<typename T>
+class ArenaNode;
+template<typename T>
+class ArenaTree;
+
+namespace details {
+inline constexpr std::uint32_t ARENA_TREE_NIL = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Node storage of ArenaTree. Blocks double in size and never move, so references to nodes stay valid until they are removed.
+ */
+template<typename T>
+class ArenaTreeStorage {
+ public:
+  constexpr static std::uint32_t FIRST_BLOCK_SIZE = 64;
+
+  ArenaTreeStorage() = default;
+  ArenaTreeStorage(const ArenaTreeStorage &) = delete;
+  ArenaTreeStorage &operator=(const ArenaTreeStorage &) = delete;
+  ~ArenaTreeStorage() {
+    clear();
+    auto allocator = std::allocator<ArenaNode<T>>{};
+    for (std::size_t i = 0; i < blocks.size(); ++i) { allocator.deallocate(blocks[i], blockSize(i)); }
+  }
+
+  [[nodiscard]] ArenaNode<T> &node(std::uint32_t index) {
+    const auto [block, offset] = locate(index);
+    return blocks[block][offset];
+  }
+
+  template<typename... Args>
+  [[nodiscard]] std::uint32_t create(std::uint32_t parent, Args &&...args) {
+    std::uint32_t index;
+    const auto reused = !freeIndices.empty();
+    if (reused) {
+      index = freeIndices.back();
+      freeIndices.pop_back();
+    } else {
+      if (usedCount == ARENA_TREE_NIL) { throw std::length_error{"ArenaTree node indices are 32 bit"}; }
+      if (usedCount == capacity()) { addBlock(); }
+      index = usedCount++;
+    }
+    try {
+      std::construct_at(&node(index), this, index, parent, std::forward<Args>(args)...);
+    } catch (...) {
+      // the popped index still fits into freeIndices' capacity, so neither branch can throw
+      if (reused) {
+        freeIndices.emplace_back(index);
+      } else {
+        --usedCount;
+      }
+      throw;
+    }
+    ++liveCount;
+    return index;
+  }
+
+  /**
+   * Destroy a node and all of its descendants, the node has to be unlinked from its parent already.
+   */
+  void destroySubtree(std::uint32_t index) {
+    auto stack = std::vector<std::uint32_t>{index};
+    while (!stack.empty()) {
+      auto &current = node(stack.back());
+      stack.pop_back();
+      for (auto child = current.firstChild; child != ARENA_TREE_NIL; child = node(child).nextSibling) { stack.emplace_back(child); }
+      freeIndices.emplace_back(current.index);
+      std::destroy_at(&current);
+      --liveCount;
+    }
+  }
+
+  /**
+   * Release all nodes, blocks are kept for reuse. Doesn't visit the nodes at all when T is trivially destructible.
+   */
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      if (root != ARENA_TREE_NIL) { destroySubtree(root); }
+    }
+    root = ARENA_TREE_NIL;
+    usedCount = 0;
+    liveCount = 0;
+    freeIndices.clear();
+  }
+
+  void reserve(std::uint32_t count) {
+    while (capacity() < count) { addBlock(); }
+  }
+
+  [[nodiscard]] std::uint64_t capacity() const { return FIRST_BLOCK_SIZE * ((std::uint64_t{1} << blocks.size()) - 1); }
+
+  std::uint32_t root = ARENA_TREE_NIL;
+  std::uint32_t liveCount = 0;
+
+ private:
+  [[nodiscard]] static std::size_t blockSize(std::size_t block) { return std::size_t{FIRST_BLOCK_SIZE} << block; }
+
+  /**
+   * Block i holds indices [FIRST_BLOCK_SIZE * (2^i - 1), FIRST_BLOCK_SIZE * (2^(i + 1) - 1)).
+   */
+  [[nodiscard]] static std::pair<std::size_t, std::size_t> locate(std::uint32_t index) {
+    const auto block = static_cast<std::size_t>(std::bit_width(index / FIRST_BLOCK_SIZE + 1) - 1);
+    return {block, index - FIRST_BLOCK_SIZE * ((std::size_t{1} << block) - 1)};
+  }
+
+  void addBlock() { blocks.emplace_back(std::allocator<ArenaNode<T>>{}.allocate(blockSize(blocks.size()))); }
+
+  std::vector<ArenaNode<T> *> blocks;
+  std::vector<std::uint32_t> freeIndices;
+  std::uint32_t usedCount = 0;
+};
+}// namespace details
+
+namespace tree_traversal {
+/**
+ * @brief Iterator over an ArenaTree subtree. Depth first traversal follows sibling links and doesn't allocate, nodes are visited in
+ * preorder with children in their order.
+ */
+template<typename T, bool IsConst, bool IsNode, Type TravType>
+class ArenaTreeIterator {
+  using underlying_type = std::conditional_t<IsNode, ArenaNode<T>, T>;
+
+ public:
+  using difference_type = long long;
+  using value_type = std::conditional_t<IsConst, const underlying_type, underlying_type>;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using iterator_category = std::forward_iterator_tag;
+
+  ArenaTreeIterator() = default;
+  ArenaTreeIterator(details::ArenaTreeStorage<T> *storage, std::uint32_t start) : storage(storage), current(start), start(start) {
+    if constexpr (TravType == Type::BreadthFirst) {
+      if (current != details::ARENA_TREE_NIL) { pushChildren(); }
+    }
+  }
+
+  bool operator==(const ArenaTreeIterator &rhs) const { return current == rhs.current; }
+  bool operator!=(const ArenaTreeIterator &rhs) const { return !(*this == rhs); }
+
+  reference operator*() const {
+    if constexpr (IsNode) {
+      return storage->node(current);
+    } else {
+      return *storage->node(current);
+    }
+  }
+  pointer operator->() const { return &operator*(); }
+
+  ArenaTreeIterator &operator++() {
+    if constexpr (TravType == Type::DepthFirst) {
+      current = nextDepthFirst();
+    } else {
+      if (queue.empty()) {
+        current = details::ARENA_TREE_NIL;
+        return *this;
+      }
+      current = queue.front();
+      queue.pop();
+      pushChildren();
+    }
+    return *this;
+  }
+  ArenaTreeIterator operator++(int) {
+    auto copy = *this;
+    operator++();
+    return copy;
+  }
+
+ private:
+  [[nodiscard]] std::uint32_t nextDepthFirst() const {
+    if (const auto firstChild = storage->node(current).firstChild; firstChild != details::ARENA_TREE_NIL) { return firstChild; }
+    for (auto index = current; index != start; index = storage->node(index).parent) {
+      if (const auto sibling = storage->node(index).nextSibling; sibling != details::ARENA_TREE_NIL) { return sibling; }
+    }
+    return details::ARENA_TREE_NIL;
+  }
+  void pushChildren() {
+    for (auto child = storage->node(current).firstChild; child != details::ARENA_TREE_NIL; child = storage->node(child).nextSibling) {
+      queue.push(child);
+    }
+  }
+
+  details::ArenaTreeStorage<T> *storage = nullptr;
+  std::uint32_t current = details::ARENA_TREE_NIL;
+  std::uint32_t start = details::ARENA_TREE_NIL;
+  PF_NOUNIQUEADDRESS std::conditional_t<TravType == Type::BreadthFirst, std::queue<std::uint32_t>, std::tuple<>> queue;
+};
+
+template<typename T, bool IsConst, bool IsNode, Type TravType>
+class ArenaTreeIteration {
+ public:
+  ArenaTreeIteration(details::ArenaTreeStorage<T> *storage, std::uint32_t start) : storage(storage), start(start) {}
+  ArenaTreeIterator<T, IsConst, IsNode, TravType> begin() { return {storage, start}; }
+  ArenaTreeIterator<T, IsConst, IsNode, TravType> end() { return {}; }
+  ArenaTreeIterator<T, true, IsNode, TravType> cbegin() { return {storage, start}; }
+  ArenaTreeIterator<T, true, IsNode, TravType> cend() { return {}; }
+
+ private:
+  details::ArenaTreeStorage<T> *storage;
+  std::uint32_t start;
+};
+}// namespace tree_traversal
+
+/**
+ * @brief Range of children of an ArenaNode.
+ */
+template<typename T, bool IsConst>
+class ArenaNodeChildren {
+ public:
+  class Iterator {
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::conditional_t<IsConst, const ArenaNode<T>, ArenaNode<T>>;
+    using pointer = value_type *;
+    using reference = value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    Iterator() = default;
+    Iterator(details::ArenaTreeStorage<T> *storage, std::uint32_t index) : storage(storage), index(index) {}
+
+    bool operator==(const Iterator &rhs) const { return index == rhs.index; }
+    reference operator*() const { return storage->node(index); }
+    pointer operator->() const { return &storage->node(index); }
+    Iterator &operator++() {
+      index = storage->node(index).nextSibling;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto copy = *this;
+      operator++();
+      return copy;
+    }
+
+   private:
+    details::ArenaTreeStorage<T> *storage = nullptr;
+    std::uint32_t index = details::ARENA_TREE_NIL;
+  };
+
+  ArenaNodeChildren(details::ArenaTreeStorage<T> *storage, std::uint32_t firstChild, std::uint32_t count)
+      : storage(storage), firstChild(firstChild), count(count) {}
+
+  [[nodiscard]] Iterator begin() const { return {storage, firstChild}; }
+  [[nodiscard]] Iterator end() const { return {}; }
+  [[nodiscard]] std::size_t size() const { return count; }
+  [[nodiscard]] bool empty() const { return count == 0; }
+
+ private:
+  details::ArenaTreeStorage<T> *storage;
+  std::uint32_t firstChild;
+  std::uint32_t count;
+};
+
+/**
+ * @brief Node of ArenaTree. It has the same interface as Node, children are linked through 32 bit indices into the tree's storage.
+ * Nodes are owned by the tree, removal of a child destroys its whole subtree.
+ * @tparam T type of inner value
+ */
+template<typename T>
+class ArenaNode {
+  friend class details::ArenaTreeStorage<T>;
+  template<typename, bool, bool, tree_traversal::Type>
+  friend class tree_traversal::ArenaTreeIterator;
+  template<typename, bool>
+  friend class ArenaNodeChildren;
+  friend class ArenaTree<T>;
+
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using rvalue = T &&;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+
+  template<typename... Args>
+  ArenaNode(details::ArenaTreeStorage<T> *storage, index_type index, index_type parent, Args &&...args)
+      : value_(std::forward<Args>(args)...), storage(storage), index(index), parent(parent) {}
+  ArenaNode(const ArenaNode &) = delete;
+  ArenaNode &operator=(const ArenaNode &) = delete;
+
+  [[nodiscard]] reference operator*() { return value_; }
+  [[nodiscard]] const_reference operator*() const { return value_; }
+
+  [[nodiscard]] pointer operator->() { return &value_; }
+  [[nodiscard]] const_pointer operator->() const { return &value_; }
+
+  [[nodiscard]] reference value() { return value_; }
+  [[nodiscard]] const_reference value() const { return value_; }
+
+  /**
+   * @return index of the node in its tree, stable for the node's lifetime
+   */
+  [[nodiscard]] index_type getIndex() const { return index; }
+
+  ArenaNode &appendChild(const_reference val) { return linkBefore(details::ARENA_TREE_NIL, storage->create(index, val)); }
+  ArenaNode &appendChild()
+    requires std::is_default_constructible_v<T>
+  {
+    return linkBefore(details::ARENA_TREE_NIL, storage->create(index));
+  }
+  ArenaNode &appendChild(rvalue val) { return linkBefore(details::ARENA_TREE_NIL, storage->create(index, std::move(val))); }
+
+  ArenaNode &insertChild(size_type idx, const_reference val) {
+    assert(idx < childrenSize());
+    return linkBefore(childAt(idx), storage->create(index, val));
+  }
+  ArenaNode &insertChild(size_type idx)
+    requires std::is_default_constructible_v<T>
+  {
+    assert(idx < childrenSize());
+    return linkBefore(childAt(idx), storage->create(index));
+  }
+  ArenaNode &insertChild(size_type idx, rvalue val) {
+    assert(idx < childrenSize());
+    return linkBefore(childAt(idx), storage->create(index, std::move(val)));
+  }
+
+  /**
+   * Destroy a child and its whole subtree.
+   */
+  void removeChild(size_type idx) {
+    assert(idx < childrenSize());
+    const auto child = childAt(idx);
+    unlink(child);
+    storage->destroySubtree(child);
+  }
+
+  void clearChildren() {
+    while (firstChild != details::ARENA_TREE_NIL) {
+      const auto child = firstChild;
+      unlink(child);
+      storage->destroySubtree(child);
+    }
+  }
+
+  [[nodiscard]] ArenaNodeChildren<T, false> children() { return {storage, firstChild, childCount}; }
+  [[nodiscard]] ArenaNodeChildren<T, true> children() const { return {storage, firstChild, childCount}; }
+
+  void sortChildren(std::predicate<T, T> auto pred) {
+    auto childIndices = std::vector<index_type>{};
+    childIndices.reserve(childCount);
+    for (auto child = firstChild; child != details::ARENA_TREE_NIL; child = storage->node(child).nextSibling) {
+      childIndices.emplace_back(child);
+    }
+    std::ranges::sort(childIndices, [&](index_type lhs, index_type rhs) { return pred(*storage->node(lhs), *storage->node(rhs)); });
+    firstChild = lastChild = details::ARENA_TREE_NIL;
+    childCount = 0;
+    for (const auto child : childIndices) { linkBefore(details::ARENA_TREE_NIL, child); }
+  }
+
+  [[nodiscard]] size_type childrenSize() const { return childCount; }
+
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() const {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, false, tree_traversal::Type::DepthFirst> iterDepthFirst() {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, false, tree_traversal::Type::DepthFirst> iterDepthFirst() const {
+    return {storage, index};
+  }
+
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() const {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() {
+    return {storage, index};
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() const {
+    return {storage, index};
+  }
+
+ private:
+  [[nodiscard]] index_type childAt(size_type idx) const {
+    auto child = firstChild;
+    for (size_type i = 0; i < idx; ++i) { child = storage->node(child).nextSibling; }
+    return child;
+  }
+
+  /**
+   * Link a node as a child before the given sibling, or at the end for ARENA_TREE_NIL.
+   */
+  ArenaNode &linkBefore(index_type sibling, index_type child) {
+    auto &childNode = storage->node(child);
+    childNode.parent = index;
+    childNode.nextSibling = sibling;
+    childNode.prevSibling = sibling == details::ARENA_TREE_NIL ? lastChild : storage->node(sibling).prevSibling;
+    if (childNode.prevSibling != details::ARENA_TREE_NIL) {
+      storage->node(childNode.prevSibling).nextSibling = child;
+    } else {
+      firstChild = child;
+    }
+    if (sibling != details::ARENA_TREE_NIL) {
+      storage->node(sibling).prevSibling = child;
+    } else {
+      lastChild = child;
+    }
+    ++childCount;
+    return childNode;
+  }
+
+  void unlink(index_type child) {
+    auto &childNode = storage->node(child);
+    if (childNode.prevSibling != details::ARENA_TREE_NIL) {
+      storage->node(childNode.prevSibling).nextSibling = childNode.nextSibling;
+    } else {
+      firstChild = childNode.nextSibling;
+    }
+    if (childNode.nextSibling != details::ARENA_TREE_NIL) {
+      storage->node(childNode.nextSibling).prevSibling = childNode.prevSibling;
+    } else {
+      lastChild = childNode.prevSibling;
+    }
+    --childCount;
+  }
+
+  T value_;
+  details::ArenaTreeStorage<T> *storage;
+  index_type index;
+  index_type parent;
+  index_type firstChild = details::ARENA_TREE_NIL;
+  index_type lastChild = details::ARENA_TREE_NIL;
+  index_type nextSibling = details::ARENA_TREE_NIL;
+  index_type prevSibling = details::ARENA_TREE_NIL;
+  index_type childCount = 0;
+};
+
+/**
+ * @brief Tree with the interface of Tree, which allocates nodes in contiguous blocks instead of one by one.
+ *
+ * Blocks double in size, so building a tree of n nodes takes O(log n) allocations and nodes created together are close in memory.
+ * Nodes refer to each other by 32 bit indices. Destroying or clearing the tree releases whole blocks - for trivially destructible T
+ * the nodes aren't visited at all. Moving the tree keeps references to its nodes valid.
+ *
+ * Depth first iteration visits children in their order and doesn't allocate.
+ * @tparam T type of inner value
+ */
+template<typename T>
+class ArenaTree {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using rvalue = T &&;
+  using node_type = ArenaNode<T>;
+
+  ArenaTree() = default;
+  explicit ArenaTree(rvalue val) { initRoot(std::move(val)); }
+  explicit ArenaTree(const_reference val) { initRoot(val); }
+  ArenaTree(const ArenaTree &) = delete;
+  ArenaTree &operator=(const ArenaTree &) = delete;
+  ArenaTree(ArenaTree &&) noexcept = default;
+  ArenaTree &operator=(ArenaTree &&) noexcept = default;
+
+  ArenaNode<T> &initRoot(rvalue val) {
+    prepareRoot();
+    storage->root = storage->create(details::ARENA_TREE_NIL, std::move(val));
+    return getRoot();
+  }
+  ArenaNode<T> &initRoot(const_reference val) {
+    prepareRoot();
+    storage->root = storage->create(details::ARENA_TREE_NIL, val);
+    return getRoot();
+  }
+
+  [[nodiscard]] ArenaNode<T> &getRoot() { return storage->node(storage->root); }
+  [[nodiscard]] const ArenaNode<T> &getRoot() const { return storage->node(storage->root); }
+
+  [[nodiscard]] bool hasRoot() const { return storage != nullptr && storage->root != details::ARENA_TREE_NIL; }
+
+  /**
+   * @param index index obtained from ArenaNode::getIndex()
+   */
+  [[nodiscard]] ArenaNode<T> &getNode(std::uint32_t index) { return storage->node(index); }
+  [[nodiscard]] const ArenaNode<T> &getNode(std::uint32_t index) const { return storage->node(index); }
+
+  /**
+   * @return count of nodes
+   */
+  [[nodiscard]] size_type size() const { return storage == nullptr ? 0 : storage->liveCount; }
+  /**
+   * @return maximal count of nodes, limited by 32 bit indices
+   */
+  [[nodiscard]] constexpr static size_type max_size() noexcept { return details::ARENA_TREE_NIL; }
+  /**
+   * Allocate storage for at least count nodes.
+   * @throws std::length_error when count exceeds max_size()
+   */
+  void reserve(size_type count) {
+    if (count > max_size()) { throw std::length_error{"ArenaTree node indices are 32 bit"}; }
+    if (storage == nullptr) { storage = std::make_unique<details::ArenaTreeStorage<T>>(); }
+    storage->reserve(static_cast<std::uint32_t>(count));
+  }
+  /**
+   * Remove all nodes, allocated blocks are kept for reuse.
+   */
+  void clear() {
+    if (storage != nullptr) { storage->clear(); }
+  }
+
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() {
+    return getRoot().iterBreadthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() const {
+    return getRoot().iterBreadthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, false, tree_traversal::Type::DepthFirst> iterDepthFirst() {
+    return getRoot().iterDepthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, false, tree_traversal::Type::DepthFirst> iterDepthFirst() const {
+    return getRoot().iterDepthFirst();
+  }
+
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() {
+    return getRoot().iterNodesBreadthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() const {
+    return getRoot().iterNodesBreadthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, false, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() {
+    return getRoot().iterNodesDepthFirst();
+  }
+  [[nodiscard]] tree_traversal::ArenaTreeIteration<T, true, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() const {
+    return getRoot().iterNodesDepthFirst();
+  }
+
+ private:
+  void prepareRoot() {
+    if (storage == nullptr) { storage = std::make_unique<details::ArenaTreeStorage<T>>(); }
+    storage->clear();
+  }
+
+  // null only in a moved from tree
+  std::unique_ptr<details::ArenaTreeStorage<T>> storage = std::make_unique<details::ArenaTreeStorage<T>>();
+};
+}// namespace pf
+
+namespace std::ranges {
+template<typename T, bool IsConst, bool IsNode, pf::tree_traversal::Type TravType>
+inline constexpr bool enable_borrowed_range<pf::tree_traversal::ArenaTreeIteration<T, IsConst, IsNode, TravType>> = true;
+}
+
+#endif//PF_COMMON_ARENATREE_H
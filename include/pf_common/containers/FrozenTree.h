@@ -0,0 +1,230 @@
+/**
+ * @file FrozenTree.h
+ * @brief Immutable tree stored in flat arrays in preorder.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+#ifndef PF_COMMON_FROZENTREE_H
+#define PF_COMMON_FROZENTREE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <pf_common/containers/ArenaTree.h>
+#include <pf_common/containers/Tree.h>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace pf {
+/**
+ * @brief Immutable tree with nodes stored in preorder in flat arrays, created by freeze().
+ *
+ * Nodes are identified by their preorder index, the root is 0. Subtree of node i occupies indices [i, subtreeEnd(i)), so depth first
+ * traversal is a linear scan of values and skipping a subtree is O(1). Breadth first order is precomputed, split by levels.
+ * @tparam T type of inner value
+ */
+template<typename T>
+class FrozenTree {
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+
+  constexpr static index_type NO_PARENT = std::numeric_limits<index_type>::max();
+
+  /**
+   * @brief Range of indices of a node's children.
+   */
+  class ChildrenRange {
+   public:
+    class Iterator {
+     public:
+      using difference_type = std::ptrdiff_t;
+      using value_type = index_type;
+
+      Iterator() = default;
+      Iterator(const FrozenTree *tree, index_type index) : tree(tree), index(index) {}
+
+      bool operator==(const Iterator &rhs) const { return index == rhs.index; }
+      index_type operator*() const { return index; }
+      Iterator &operator++() {
+        index = tree->subtreeEnd(index);
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto copy = *this;
+        operator++();
+        return copy;
+      }
+
+     private:
+      const FrozenTree *tree = nullptr;
+      index_type index = 0;
+    };
+
+    ChildrenRange(const FrozenTree *tree, index_type first, index_type last) : tree(tree), first(first), last(last) {}
+    [[nodiscard]] Iterator begin() const { return {tree, first}; }
+    [[nodiscard]] Iterator end() const { return {tree, last}; }
+    [[nodiscard]] bool empty() const { return first == last; }
+
+   private:
+    const FrozenTree *tree;
+    index_type first;
+    index_type last;
+  };
+
+  FrozenTree() = default;
+  /**
+   * @param values values in preorder
+   * @param parents parent index of each node, NO_PARENT for the root at index 0
+   * @param depths depth of each node, 0 for the root
+   */
+  FrozenTree(std::vector<T> &&values, std::vector<index_type> &&parents, std::span<const index_type> depths)
+      : values_(std::move(values)), subtreeSizes(values_.size(), 1), parents(std::move(parents)) {
+    assert(this->parents.size() == values_.size() && depths.size() == values_.size());
+    const auto nodeCount = values_.size();
+    if (nodeCount == 0) { return; }
+    for (auto i = nodeCount; i > 1; --i) { subtreeSizes[this->parents[i - 1]] += subtreeSizes[i - 1]; }
+
+    // preorder sorted by depth is the breadth first order, counting sort keeps it stable
+    levelOffsets.assign(static_cast<std::size_t>(*std::ranges::max_element(depths)) + 2, 0);
+    for (const auto depth : depths) { ++levelOffsets[depth + 1]; }
+    for (std::size_t i = 1; i < levelOffsets.size(); ++i) { levelOffsets[i] += levelOffsets[i - 1]; }
+    breadthFirstOrder.resize(nodeCount);
+    auto levelPositions = std::vector<index_type>(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (std::size_t i = 0; i < nodeCount; ++i) { breadthFirstOrder[levelPositions[depths[i]]++] = static_cast<index_type>(i); }
+  }
+
+  [[nodiscard]] size_type size() const { return values_.size(); }
+  [[nodiscard]] bool empty() const { return values_.empty(); }
+
+  [[nodiscard]] const_reference operator[](index_type index) const { return values_[index]; }
+  [[nodiscard]] const_reference value(index_type index) const { return values_[index]; }
+  /**
+   * @return all values in preorder
+   */
+  [[nodiscard]] std::span<const T> values() const { return values_; }
+
+  [[nodiscard]] index_type subtreeSize(index_type index) const { return subtreeSizes[index]; }
+  /**
+   * @return index following the last node of the subtree - next node in depth first order which isn't a descendant
+   */
+  [[nodiscard]] index_type subtreeEnd(index_type index) const { return index + subtreeSizes[index]; }
+  /**
+   * @return parent's index or NO_PARENT for the root
+   */
+  [[nodiscard]] index_type parent(index_type index) const { return parents[index]; }
+  [[nodiscard]] bool isLeaf(index_type index) const { return subtreeSizes[index] == 1; }
+  [[nodiscard]] ChildrenRange children(index_type index) const { return {this, index + 1, subtreeEnd(index)}; }
+  [[nodiscard]] size_type childrenSize(index_type index) const {
+    return static_cast<size_type>(std::ranges::distance(children(index)));
+  }
+
+  /**
+   * @return values of the subtree in preorder
+   */
+  [[nodiscard]] std::span<const T> iterDepthFirst(index_type index = 0) const {
+    return empty() ? std::span<const T>{} : std::span{values_}.subspan(index, subtreeSizes[index]);
+  }
+  /**
+   * @return values of the whole tree in breadth first order
+   */
+  [[nodiscard]] auto iterBreadthFirst() const {
+    return breadthFirstOrder | std::views::transform([this](index_type index) -> const T & { return values_[index]; });
+  }
+
+  [[nodiscard]] size_type levelCount() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1; }
+  /**
+   * @param depth depth of the level, root's level is 0
+   * @return indices of nodes of the level, in breadth first order
+   */
+  [[nodiscard]] std::span<const index_type> level(size_type depth) const {
+    return std::span{breadthFirstOrder}.subspan(levelOffsets[depth], levelOffsets[depth + 1] - levelOffsets[depth]);
+  }
+
+ private:
+  std::vector<T> values_;
+  std::vector<index_type> subtreeSizes;
+  std::vector<index_type> parents;
+  std::vector<index_type> breadthFirstOrder;
+  std::vector<index_type> levelOffsets;
+};
+
+/**
+ * Build FrozenTree from a subtree of Node or ArenaNode.
+ * @tparam MoveValues move values out of the nodes instead of copying them
+ */
+template<typename N, bool MoveValues = false>
+[[nodiscard]] FrozenTree<typename std::remove_const_t<N>::value_type> freezeSubtree(N &root) {
+  using Result = FrozenTree<typename std::remove_const_t<N>::value_type>;
+  using index_type = typename Result::index_type;
+  auto values = std::vector<typename Result::value_type>{};
+  auto parents = std::vector<index_type>{};
+  auto depths = std::vector<index_type>{};
+  struct Pending {
+    N *node;
+    index_type parent;
+    index_type depth;
+  };
+  auto stack = std::vector<Pending>{{&root, Result::NO_PARENT, 0}};
+  while (!stack.empty()) {
+    const auto [node, parent, depth] = stack.back();
+    stack.pop_back();
+    assert(values.size() < Result::NO_PARENT && "FrozenTree node indices are 32 bit");
+    const auto index = static_cast<index_type>(values.size());
+    if constexpr (MoveValues) {
+      values.emplace_back(std::move(**node));
+    } else {
+      values.emplace_back(**node);
+    }
+    parents.emplace_back(parent);
+    depths.emplace_back(depth);
+    // children are pushed in reverse so the first one is popped first
+    const auto firstPushed = stack.size();
+    for (auto &child : node->children()) { stack.emplace_back(Pending{&child, index, depth + 1}); }
+    std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(firstPushed), stack.end());
+  }
+  return Result{std::move(values), std::move(parents), depths};
+}
+
+/**
+ * Convert a tree into FrozenTree, values are copied.
+ */
+template<typename T>
+[[nodiscard]] FrozenTree<T> freeze(const Tree<T> &tree) {
+  if (!tree.hasRoot()) { return {}; }
+  return freezeSubtree(tree.getRoot());
+}
+/**
+ * Convert a tree into FrozenTree, values are moved out of the tree.
+ */
+template<typename T>
+[[nodiscard]] FrozenTree<T> freeze(Tree<T> &&tree) {
+  if (!tree.hasRoot()) { return {}; }
+  return freezeSubtree<Node<T>, true>(tree.getRoot());
+}
+/**
+ * Convert a tree into FrozenTree, values are copied.
+ */
+template<typename T>
+[[nodiscard]] FrozenTree<T> freeze(const ArenaTree<T> &tree) {
+  if (!tree.hasRoot()) { return {}; }
+  return freezeSubtree(tree.getRoot());
+}
+/**
+ * Convert a tree into FrozenTree, values are moved out of the tree.
+ */
+template<typename T>
+[[nodiscard]] FrozenTree<T> freeze(ArenaTree<T> &&tree) {
+  if (!tree.hasRoot()) { return {}; }
+  return freezeSubtree<ArenaNode<T>, true>(tree.getRoot());
+}
+}// namespace pf
+
+#endif//PF_COMMON_FROZENTREE_H
@@ -8,27 +8,44 @@
 #define PF_COMMON_TREE_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <functional>
 #include <memory>
-#include <queue>
 #include <ranges>
-#include <stack>
+#include <vector>
 
 namespace pf {
 namespace tree_traversal {
 enum class Type { DepthFirst, BreadthFirst };
+/**
+ * @brief Value a visitor of the free traversal functions can return to control the traversal.
+ */
+enum class Action {
+  Continue,   ///< continue with the node's children
+  SkipSubtree,///< don't visit the node's descendants
+  Stop        ///< end the whole traversal
+};
 
 template<typename T, bool IsConst, bool IsNode, Type TravType>
 class TreeIteration;
+template<typename T, bool IsConst, bool IsNode, Type TravType>
+class TreeIterator;
 
 }// namespace tree_traversal
 
 //TODO: STL like iterators
 /**
  * @brief Node of a tree with a variable amount of child nodes.
+ * Each node links to its parent and next sibling, so iterators can traverse the tree without any auxiliary structure.
  * @tparam T type of inner value
  */
 template<typename T>
 class Node {
+  template<typename, bool, bool, tree_traversal::Type>
+  friend class tree_traversal::TreeIterator;
+
  public:
   using value_type = T;
   using pointer = T *;
@@ -45,8 +62,19 @@ class Node {
   explicit Node(const_reference val) : value_(val) {}
   Node(const Node &) = delete;
   Node &operator=(const Node &) = delete;
-  Node(Node &&) noexcept = default;
-  Node &operator=(Node &&) noexcept = default;
+  /**
+   * The new node is detached from any parent.
+   */
+  Node(Node &&other) noexcept : value_(std::move(other.value_)), children_(std::move(other.children_)) { linkChildren(0); }
+  /**
+   * The node keeps its own parent.
+   */
+  Node &operator=(Node &&other) noexcept {
+    value_ = std::move(other.value_);
+    children_ = std::move(other.children_);
+    linkChildren(0);
+    return *this;
+  }
 
   [[nodiscard]] reference operator*() { return value_; }
   [[nodiscard]] const_reference operator*() const { return value_; }
@@ -57,54 +85,55 @@ class Node {
   [[nodiscard]] reference value() { return value_; }
   [[nodiscard]] const_reference value() const { return value_; }
 
-  Node<T> &appendChild(const_reference val) {
-    children_.template emplace_back(std::make_unique<Node>(val));
-    return *children_.back();
-  }
+  Node<T> &appendChild(const_reference val) { return appendChild(std::make_unique<Node>(val)); }
   Node<T> &appendChild()
     requires std::is_default_constructible_v<T>
   {
-    children_.template emplace_back(std::make_unique<Node>());
-    return *children_.back();
-  }
-  Node<T> &appendChild(rvalue val) {
-    children_.template emplace_back(std::make_unique<Node>(std::move(val)));
-    return *children_.back();
+    return appendChild(std::make_unique<Node>());
   }
+  Node<T> &appendChild(rvalue val) { return appendChild(std::make_unique<Node>(std::move(val))); }
   Node<T> &appendChild(std::unique_ptr<Node<T>> &&child) {
+    assert(child->parent_ == nullptr);
+    child->parent_ = this;
+    if (!children_.empty()) { children_.back()->nextSibling = child.get(); }
     children_.template emplace_back(std::move(child));
     return *children_.back();
   }
 
-  Node<T> &insertChild(size_type idx, const_reference val) {
-    assert(idx < childrenSize());
-    return **children_.insert(children_.begin() + idx, std::make_unique<Node>(val));
-  }
+  Node<T> &insertChild(size_type idx, const_reference val) { return insertChild(idx, std::make_unique<Node>(val)); }
   Node<T> &insertChild(size_type idx)
     requires std::is_default_constructible_v<T>
   {
-    assert(idx < childrenSize());
-    return **children_.insert(children_.begin() + idx, std::make_unique<Node>());
-  }
-  Node<T> &insertChild(size_type idx, rvalue val) {
-    assert(idx < childrenSize());
-    return **children_.insert(children_.begin() + idx, std::make_unique<Node>(std::move(val)));
+    return insertChild(idx, std::make_unique<Node>());
   }
+  Node<T> &insertChild(size_type idx, rvalue val) { return insertChild(idx, std::make_unique<Node>(std::move(val))); }
   Node<T> &insertChild(size_type idx, std::unique_ptr<Node<T>> &&child) {
     assert(idx < childrenSize());
-    return **children_.insert(children_.begin() + idx, std::move(child));
+    assert(child->parent_ == nullptr);
+    auto &result = **children_.insert(children_.begin() + idx, std::move(child));
+    linkChildren(idx);
+    return result;
   }
 
+  /**
+   * @return removed child detached from this node
+   */
   std::unique_ptr<Node<T>> removeChild(size_type idx) {
     assert(idx < childrenSize());
     auto result = std::move(children_[idx]);
     children_.erase(children_.begin() + idx);
+    linkChildren(idx);
+    result->detach();
     return result;
   }
 
+  /**
+   * @return removed children detached from this node
+   */
   std::vector<std::unique_ptr<Node>> clearChildren() {
     auto result = std::move(children_);
     children_.clear();
+    for (auto &child : result) { child->detach(); }
     return result;
   }
 
@@ -117,10 +146,22 @@ class Node {
 
   void sortChildren(std::predicate<T, T> auto pred) {
     std::ranges::sort(children_, [pred](const auto &lhs, const auto &rhs) { return pred(**lhs, **rhs); });
+    linkChildren(0);
   }
 
   [[nodiscard]] size_type childrenSize() const { return children_.size(); }
 
+  /**
+   * @return parent node or nullptr for a root or a detached node
+   */
+  [[nodiscard]] Node *getParent() { return parent_; }
+  [[nodiscard]] const Node *getParent() const { return parent_; }
+  /**
+   * @return next child of the parent or nullptr for the last child
+   */
+  [[nodiscard]] Node *getNextSibling() { return nextSibling; }
+  [[nodiscard]] const Node *getNextSibling() const { return nextSibling; }
+
   [[nodiscard]] tree_traversal::TreeIteration<T, false, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() {
     return tree_traversal::TreeIteration<T, false, false, tree_traversal::Type::BreadthFirst>(this);
   }
@@ -148,8 +189,24 @@ class Node {
   }
 
  private:
+  /**
+   * Link children from firstIdx on to this node and to their next siblings, the child before firstIdx is relinked as well.
+   */
+  void linkChildren(size_type firstIdx) {
+    for (auto idx = firstIdx > 0 ? firstIdx - 1 : 0; idx < children_.size(); ++idx) {
+      children_[idx]->parent_ = this;
+      children_[idx]->nextSibling = idx + 1 < children_.size() ? children_[idx + 1].get() : nullptr;
+    }
+  }
+  void detach() {
+    parent_ = nullptr;
+    nextSibling = nullptr;
+  }
+
   T value_;
   std::vector<std::unique_ptr<Node>> children_;
+  Node *parent_ = nullptr;
+  Node *nextSibling = nullptr;
 };
 
 template<typename T>
@@ -183,41 +240,93 @@ class Tree {
   [[nodiscard]] bool hasRoot() const { return root != nullptr; }
 
   [[nodiscard]] tree_traversal::TreeIteration<T, false, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() {
-    return root->iterBreadthFirst();
+    return getRoot().iterBreadthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, true, false, tree_traversal::Type::BreadthFirst> iterBreadthFirst() const {
-    return root->iterBreadthFirst();
+    return getRoot().iterBreadthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, false, false, tree_traversal::Type::DepthFirst> iterDepthFirst() {
-    return root->iterDepthFirst();
+    return getRoot().iterDepthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, true, false, tree_traversal::Type::DepthFirst> iterDepthFirst() const {
-    return root->iterDepthFirst();
+    return getRoot().iterDepthFirst();
   }
 
   [[nodiscard]] tree_traversal::TreeIteration<T, false, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() {
-    return root->iterNodesBreadthFirst();
+    return getRoot().iterNodesBreadthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, true, true, tree_traversal::Type::BreadthFirst> iterNodesBreadthFirst() const {
-    return root->iterNodesBreadthFirst();
+    return getRoot().iterNodesBreadthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, false, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() {
-    return root->iterNodesDepthFirst();
+    return getRoot().iterNodesDepthFirst();
   }
   [[nodiscard]] tree_traversal::TreeIteration<T, true, true, tree_traversal::Type::DepthFirst> iterNodesDepthFirst() const {
-    return root->iterNodesDepthFirst();
+    return getRoot().iterNodesDepthFirst();
   }
 
  private:
   std::unique_ptr<Node<T>> root = nullptr;
 };
 
+namespace details {
+/**
+ * @brief Next siblings of ancestors of the node currently visited by a depth first walk, so the walk doesn't have to climb back
+ * through the ancestors. Only the deepest SIZE siblings are kept, older ones are overwritten. Once the stack runs empty the walk
+ * has to find the rest through parent links.
+ */
+template<typename N>
+struct SiblingStack {
+  constexpr static std::size_t SIZE = 16;
+
+  /**
+   * @param sibling next sibling of a node whose children are entered, nullptr is ignored
+   */
+  void push(N *sibling) {
+    if (sibling == nullptr) { return; }
+    nodes[top] = sibling;
+    top = (top + 1) % SIZE;
+    size = std::min(size + 1, SIZE);
+  }
+  /**
+   * @return the deepest stored sibling or nullptr if there is none
+   */
+  [[nodiscard]] N *pop() {
+    if (size == 0) { return nullptr; }
+    top = (top + SIZE - 1) % SIZE;
+    --size;
+    return nodes[top];
+  }
+
+  std::array<N *, SIZE> nodes{};
+  std::size_t top = 0;
+  std::size_t size = 0;
+};
+}// namespace details
+
 namespace tree_traversal {
 
+/**
+ * @brief Iterator over a subtree of Node.
+ * Depth first order is a preorder walked through child and sibling links with a fixed size details::SiblingStack, so the iterator
+ * never allocates and is trivially copyable. Breadth first order is not allocation free - the iterator owns a std::vector queue of
+ * visited nodes which have children. Leaves are never stored in it and nothing is allocated before the first node with children is
+ * reached, but every copy of the iterator, e.g. post-increment or passing it to an algorithm by value, copies the queue. Prefer
+ * pre-increment, or tree_traversal::breadthFirst when the iterator doesn't have to be copied.
+ */
 template<typename T, bool IsConst, bool IsNode, Type TravType>
 class TreeIterator {
   using underlying_type = std::conditional_t<IsNode, Node<T>, T>;
-  using iter_structure = std::conditional_t<TravType == Type::DepthFirst, std::stack<Node<T> *>, std::queue<Node<T> *>>;
+  using node_type = std::conditional_t<IsConst, const Node<T>, Node<T>>;
+
+  /**
+   * Visited nodes with children in breadth first order, children of nodes before head were already visited.
+   */
+  struct ParentQueue {
+    std::vector<node_type *> nodes;
+    std::size_t head = 0;
+    std::size_t childIdx = 0;
+  };
 
  public:
   using difference_type = long long;
@@ -227,11 +336,7 @@ class TreeIterator {
   using iterator_category = std::forward_iterator_tag;
 
   TreeIterator() = default;
-  explicit TreeIterator(Node<T> *node) : currentNode(node) {
-    if (currentNode != nullptr) {
-      for (auto &child : currentNode->children()) { stack.push(&child); }
-    }
-  }
+  explicit TreeIterator(node_type *node) : currentNode(node), startNode(node) {}
   TreeIterator(const TreeIterator &other) = default;
   TreeIterator &operator=(const TreeIterator &other) = default;
   TreeIterator(TreeIterator &&other) noexcept = default;
@@ -257,17 +362,11 @@ class TreeIterator {
   }
 
   TreeIterator &operator++() {
-    if (stack.empty()) {
-      currentNode = nullptr;
-      return *this;
-    }
-    if constexpr (TravType == Type::BreadthFirst) {
-      currentNode = stack.front();
+    if constexpr (TravType == Type::DepthFirst) {
+      currentNode = nextDepthFirst();
     } else {
-      currentNode = stack.top();
+      currentNode = nextBreadthFirst();
     }
-    stack.pop();
-    for (auto &child : currentNode->children()) { stack.push(&child); }
     return *this;
   }
 
@@ -278,81 +377,217 @@ class TreeIterator {
   }
 
  private:
-  Node<T> *currentNode = nullptr;
-  iter_structure stack;
+  [[nodiscard]] node_type *nextDepthFirst() {
+    if (!currentNode->children_.empty()) {
+      if (currentNode != startNode) { traversal.push(currentNode->nextSibling); }
+      return currentNode->children_.front().get();
+    }
+    if (currentNode != startNode && currentNode->nextSibling != nullptr) { return currentNode->nextSibling; }
+    if (const auto sibling = traversal.pop(); sibling != nullptr) { return sibling; }
+    for (auto node = currentNode; node != startNode; node = node->parent_) {
+      if (node->nextSibling != nullptr) { return node->nextSibling; }
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] node_type *nextBreadthFirst() {
+    auto &[nodes, head, childIdx] = traversal;
+    if (!currentNode->children_.empty()) {
+      // the queue is compacted once half of it is consumed, which keeps push amortized O(1)
+      if (head > 0 && head * 2 >= nodes.size()) {
+        nodes.erase(nodes.begin(), nodes.begin() + static_cast<std::ptrdiff_t>(head));
+        head = 0;
+      }
+      nodes.emplace_back(currentNode);
+    }
+    if (head == nodes.size()) { return nullptr; }
+    const auto &children = nodes[head]->children_;
+    node_type *result = children[childIdx].get();
+    if (++childIdx == children.size()) {
+      ++head;
+      childIdx = 0;
+    }
+    return result;
+  }
+
+  node_type *currentNode = nullptr;
+  node_type *startNode = nullptr;
+  std::conditional_t<TravType == Type::DepthFirst, details::SiblingStack<node_type>, ParentQueue> traversal;
 };
 
 template<typename T, bool IsConst, bool IsNode, Type TravType>
 class TreeIteration {
+  using node_type = std::conditional_t<IsConst, const Node<T>, Node<T>>;
+
  public:
-  explicit TreeIteration(Node<T> *node) : node_(node) {}
+  explicit TreeIteration(node_type *node) : node_(node) {}
   TreeIterator<T, IsConst, IsNode, TravType> begin() { return TreeIterator<T, IsConst, IsNode, TravType>(node_); }
   TreeIterator<T, IsConst, IsNode, TravType> end() { return TreeIterator<T, IsConst, IsNode, TravType>(nullptr); }
   TreeIterator<T, true, IsNode, TravType> cbegin() { return TreeIterator<T, true, IsNode, TravType>(node_); }
   TreeIterator<T, true, IsNode, TravType> cend() { return TreeIterator<T, true, IsNode, TravType>(nullptr); }
 
  private:
-  Node<T> *node_;
+  node_type *node_;
 };
 
+/**
+ * Callable invoked with a node, it can return Action to prune or stop the traversal. Any other result is ignored.
+ */
+template<typename F, typename N>
+concept Visitor = std::invocable<F &, N &>;
+
+}// namespace tree_traversal
+
+namespace details {
+template<typename N>
+tree_traversal::Action visit(tree_traversal::Visitor<N> auto &visitor, N &node) {
+  if constexpr (std::convertible_to<std::invoke_result_t<decltype(visitor), N &>, tree_traversal::Action>) {
+    return static_cast<tree_traversal::Action>(std::invoke(visitor, node));
+  } else {
+    std::invoke(visitor, node);
+    return tree_traversal::Action::Continue;
+  }
+}
+
+/**
+ * Iterative depth first traversal walking parent and sibling links, so it needs no stack regardless of the tree's depth.
+ * Without a post order hook ancestors don't have to be visited on the way up, so their siblings are taken from SiblingStack.
+ */
+template<bool HasPostOrder, typename N>
+bool depthFirst(N &root, tree_traversal::Visitor<N> auto &preOrder, tree_traversal::Visitor<N> auto &postOrder) {
+  auto pendingSiblings = SiblingStack<N>{};
+  auto node = &root;
+  while (true) {
+    const auto action = visit(preOrder, *node);
+    if (action == tree_traversal::Action::Stop) { return false; }
+    if (action == tree_traversal::Action::Continue && node->childrenSize() != 0) {
+      if (!HasPostOrder && node != &root) { pendingSiblings.push(node->getNextSibling()); }
+      node = &*node->children().begin();
+      continue;
+    }
+    if constexpr (!HasPostOrder) {
+      if (node != &root && node->getNextSibling() != nullptr) {
+        node = node->getNextSibling();
+        continue;
+      }
+      if (const auto sibling = pendingSiblings.pop(); sibling != nullptr) {
+        node = sibling;
+        continue;
+      }
+    }
+    while (true) {
+      if (visit(postOrder, *node) == tree_traversal::Action::Stop) { return false; }
+      if (node == &root) { return true; }
+      if (const auto sibling = node->getNextSibling(); sibling != nullptr) {
+        node = sibling;
+        break;
+      }
+      node = node->getParent();
+    }
+  }
+}
+
+template<typename N>
+bool breadthFirst(N &root, tree_traversal::Visitor<N> auto &visitor) {
+  auto queue = std::vector<N *>{&root};
+  for (std::size_t head = 0; head < queue.size();) {
+    // visited nodes are dropped once they make up half of the queue, so its size follows the widest level instead of the whole tree
+    if (head > 0 && head * 2 >= queue.size()) {
+      queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(head));
+      head = 0;
+    }
+    auto &node = *queue[head++];
+    const auto action = visit(visitor, node);
+    if (action == tree_traversal::Action::Stop) { return false; }
+    if (action == tree_traversal::Action::SkipSubtree) { continue; }
+    for (auto &child : node.children()) { queue.emplace_back(&child); }
+  }
+  return true;
+}
+
+constexpr auto noOpVisitor = [](const auto &) {};
+}// namespace details
+
+namespace tree_traversal {
+
+/**
+ * Visit nodes in preorder. The traversal is iterative, so the depth of the tree is not limited by the call stack.
+ * @param callable visitor, it may return Action to skip the node's subtree or stop the traversal
+ * @return false if the traversal was stopped
+ */
 template<typename T>
-void depthFirst(Node<T> &node, std::invocable<Node<T> &> auto callable) {
-  callable(node);
-  auto children = node.children();
-  for (auto &child : children) { depthFirst(child, callable); }
+bool depthFirst(Node<T> &node, Visitor<Node<T>> auto callable) {
+  return details::depthFirst<false>(node, callable, details::noOpVisitor);
+}
+/**
+ * Visit nodes calling preOrder before a node's descendants and postOrder after them.
+ * postOrder is called for nodes with skipped subtrees as well, its SkipSubtree return value is ignored.
+ * @return false if the traversal was stopped
+ */
+template<typename T>
+bool depthFirst(Node<T> &node, Visitor<Node<T>> auto preOrder, Visitor<Node<T>> auto postOrder) {
+  return details::depthFirst<true>(node, preOrder, postOrder);
+}
+template<typename T>
+bool depthFirst(Tree<T> &tree, Visitor<Node<T>> auto callable) {
+  if (!tree.hasRoot()) { return true; }
+  return depthFirst(tree.getRoot(), std::move(callable));
 }
 template<typename T>
-void depthFirst(Tree<T> &tree, std::invocable<Node<T> &> auto callable) {
-  if (!tree.hasRoot()) { return; }
-  depthFirst(tree.getRoot(), callable);
+bool depthFirst(Tree<T> &tree, Visitor<Node<T>> auto preOrder, Visitor<Node<T>> auto postOrder) {
+  if (!tree.hasRoot()) { return true; }
+  return depthFirst(tree.getRoot(), std::move(preOrder), std::move(postOrder));
 }
 
+/**
+ * Visit nodes level by level.
+ * @param callable visitor, it may return Action to skip the node's subtree or stop the traversal
+ * @return false if the traversal was stopped
+ */
 template<typename T>
-void breadthFirst(Node<T> &node, std::invocable<Node<T> &> auto callable) {
-  auto queue = std::queue<const Node<T> *>();
-  queue.push(&node);
-  while (!queue.empty()) {
-    auto currentNode = queue.front();
-    queue.pop();
-    callable(*currentNode);
-    auto children = currentNode->children();
-    for (auto &child : children) { queue.push(&child); }
-  }
+bool breadthFirst(Node<T> &node, Visitor<Node<T>> auto callable) {
+  return details::breadthFirst(node, callable);
 }
 template<typename T>
-void BreadthFirst(Tree<T> &tree, std::invocable<Node<T> &> auto callable) {
-  if (!tree.hasRoot()) { return; }
-  breadthFirst(tree.getRoot(), callable);
+bool breadthFirst(Tree<T> &tree, Visitor<Node<T>> auto callable) {
+  if (!tree.hasRoot()) { return true; }
+  return breadthFirst(tree.getRoot(), std::move(callable));
+}
+/**
+ * @deprecated use breadthFirst
+ */
+template<typename T>
+bool BreadthFirst(Tree<T> &tree, Visitor<Node<T>> auto callable) {
+  return breadthFirst(tree, std::move(callable));
 }
 
 template<typename T>
-void cDepthFirst(const Node<T> &node, std::invocable<const Node<T> &> auto callable) {
-  callable(node);
-  auto children = node.children();
-  for (const auto &child : children) { depthFirst(child, callable); }
+bool cDepthFirst(const Node<T> &node, Visitor<const Node<T>> auto callable) {
+  return details::depthFirst<false>(node, callable, details::noOpVisitor);
+}
+template<typename T>
+bool cDepthFirst(const Node<T> &node, Visitor<const Node<T>> auto preOrder, Visitor<const Node<T>> auto postOrder) {
+  return details::depthFirst<true>(node, preOrder, postOrder);
+}
+template<typename T>
+bool cDepthFirst(const Tree<T> &tree, Visitor<const Node<T>> auto callable) {
+  if (!tree.hasRoot()) { return true; }
+  return cDepthFirst(tree.getRoot(), std::move(callable));
 }
 template<typename T>
-void cDepthFirst(const Tree<T> &tree, std::invocable<const Node<T> &> auto callable) {
-  if (!tree.hasRoot()) { return; }
-  depthFirst(tree.getRoot(), callable);
+bool cDepthFirst(const Tree<T> &tree, Visitor<const Node<T>> auto preOrder, Visitor<const Node<T>> auto postOrder) {
+  if (!tree.hasRoot()) { return true; }
+  return cDepthFirst(tree.getRoot(), std::move(preOrder), std::move(postOrder));
 }
 
 template<typename T>
-void cBreadthFirst(const Node<T> &node, std::invocable<const Node<T> &> auto callable) {
-  auto queue = std::queue<const Node<T> *>();
-  queue.push(&node);
-  while (!queue.empty()) {
-    auto currentNode = queue.front();
-    queue.pop();
-    callable(*currentNode);
-    auto children = currentNode->children();
-    for (const auto &child : children) { queue.push(&child); }
-  }
+bool cBreadthFirst(const Node<T> &node, Visitor<const Node<T>> auto callable) {
+  return details::breadthFirst(node, callable);
 }
 template<typename T>
-void cBreadthFirst(const Tree<T> &tree, std::invocable<const Node<T> &> auto callable) {
-  if (!tree.hasRoot()) { return; }
-  breadthFirst(tree.getRoot(), callable);
+bool cBreadthFirst(const Tree<T> &tree, Visitor<const Node<T>> auto callable) {
+  if (!tree.hasRoot()) { return true; }
+  return cBreadthFirst(tree.getRoot(), std::move(callable));
 }
 
 }// namespace tree_traversal
@@ -363,9 +598,5 @@ namespace std::ranges {
 template<typename T, bool IsConst, bool IsNode, pf::tree_traversal::Type TravType>
 inline constexpr bool enable_borrowed_range<pf::tree_traversal::TreeIteration<T, IsConst, IsNode, TravType>> = true;
 }
-namespace ranges {
-template<typename T, bool IsConst, bool IsNode, pf::tree_traversal::Type TravType>
-inline constexpr bool enable_borrowed_range<pf::tree_traversal::TreeIteration<T, IsConst, IsNode, TravType>> = true;
-}
 
 #endif//PF_COMMON_TREE_H
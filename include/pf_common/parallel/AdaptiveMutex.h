@@ -0,0 +1,55 @@
+/**
+ * @file AdaptiveMutex.h
+ * @brief Mutex spinning for a while before putting the thread to sleep.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_ADAPTIVEMUTEX_H
+#define PF_COMMON_PARALLEL_ADAPTIVEMUTEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <pf_common/parallel/SpinMutex.h>
+
+namespace pf {
+/**
+ * @brief Mutex which spins for a bounded time and then parks the thread on std::atomic::wait (futex on Linux).
+ *
+ * Uncontended lock and unlock are a single atomic operation, unlock only makes a syscall when there may be a parked thread.
+ * Satisfies Lockable requirements.
+ */
+class AdaptiveMutex {
+ public:
+  constexpr static unsigned SPIN_COUNT = 128;
+
+  AdaptiveMutex() = default;
+  AdaptiveMutex(const AdaptiveMutex &) = delete;
+  AdaptiveMutex &operator=(const AdaptiveMutex &) = delete;
+
+  void lock() noexcept {
+    for (auto i = 0u; i < SPIN_COUNT; ++i) {
+      if (state.load(std::memory_order_relaxed) == Unlocked && try_lock()) { return; }
+      details::cpuPause();
+    }
+    // from now on the lock is marked as contended so that unlock wakes a parked thread
+    while (state.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked) {
+      state.wait(LockedWithWaiters, std::memory_order_relaxed);
+    }
+  }
+  [[nodiscard]] bool try_lock() noexcept {
+    std::uint32_t expected = Unlocked;
+    return state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+  void unlock() noexcept {
+    if (state.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters) { state.notify_one(); }
+  }
+
+ private:
+  enum State : std::uint32_t { Unlocked, Locked, LockedWithWaiters };
+
+  std::atomic<std::uint32_t> state = Unlocked;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_ADAPTIVEMUTEX_H
@@ -0,0 +1,21 @@
+/**
+ * @file CacheLine.h
+ * @brief Cache line size used for padding of shared data.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_CACHELINE_H
+#define PF_COMMON_PARALLEL_CACHELINE_H
+
+#include <cstddef>
+
+namespace pf {
+/**
+ * Size used to separate data written by different threads to avoid false sharing.
+ * std::hardware_destructive_interference_size is not used since it's not available everywhere and gcc warns about its ABI stability.
+ */
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_CACHELINE_H
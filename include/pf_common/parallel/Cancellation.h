@@ -0,0 +1,51 @@
+/**
+ * @file Cancellation.h
+ * @brief Cooperative cancellation of tasks run on ThreadPool.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_CANCELLATION_H
+#define PF_COMMON_PARALLEL_CANCELLATION_H
+
+#include <exception>
+#include <future>
+#include <stop_token>
+#include <utility>
+
+namespace pf {
+/**
+ * @brief Stored in a future of a task which was cancelled before it started.
+ */
+class TaskCancelled : public std::exception {
+ public:
+  [[nodiscard]] const char *what() const noexcept override { return "Task was cancelled before it started"; }
+};
+
+/**
+ * @brief Future of a task accepting std::stop_token, allows to request the task to stop.
+ *
+ * A task which hasn't started yet when stop is requested is not run at all and the future holds TaskCancelled. A running task is
+ * only notified through its std::stop_token and it's up to the task to finish early.
+ */
+template<typename T>
+class CancellableFuture : public std::future<T> {
+ public:
+  CancellableFuture() = default;
+  CancellableFuture(std::future<T> &&future, std::stop_source stopSource)
+      : std::future<T>(std::move(future)), stopSource(std::move(stopSource)) {}
+
+  /**
+   * Request the task to stop.
+   * @return true if this call made the stop request
+   */
+  bool requestStop() noexcept { return stopSource.request_stop(); }
+  [[nodiscard]] bool isStopRequested() const noexcept { return stopSource.stop_requested(); }
+  [[nodiscard]] std::stop_source getStopSource() const noexcept { return stopSource; }
+
+ private:
+  std::stop_source stopSource;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_CANCELLATION_H
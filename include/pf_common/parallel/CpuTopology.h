@@ -0,0 +1,134 @@
+/**
+ * @file CpuTopology.h
+ * @brief NUMA topology detection and thread pinning.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_CPUTOPOLOGY_H
+#define PF_COMMON_PARALLEL_CPUTOPOLOGY_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pf {
+/**
+ * @brief A NUMA node and its logical cpus.
+ */
+struct NumaNode {
+  std::size_t id;
+  std::vector<std::size_t> cpus;
+};
+
+namespace details {
+/**
+ * Parse cpu list in the kernel's format, e.g. "0-3,8,10-11".
+ * @return cpu ids or std::nullopt if the list is malformed
+ */
+[[nodiscard]] inline std::optional<std::vector<std::size_t>> parseCpuList(std::string_view list) {
+  const auto parseNumber = [](std::string_view text) -> std::optional<std::size_t> {
+    std::size_t result{};
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), result);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) { return std::nullopt; }
+    return result;
+  };
+  while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) { list.remove_suffix(1); }
+  auto result = std::vector<std::size_t>{};
+  while (!list.empty()) {
+    const auto comma = list.find(',');
+    const auto range = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    const auto dash = range.find('-');
+    const auto first = parseNumber(range.substr(0, dash));
+    const auto last = dash == std::string_view::npos ? first : parseNumber(range.substr(dash + 1));
+    if (!first.has_value() || !last.has_value() || *last < *first) { return std::nullopt; }
+    for (auto cpu = *first; cpu <= *last; ++cpu) { result.emplace_back(cpu); }
+  }
+  return result;
+}
+}// namespace details
+
+/**
+ * Read NUMA topology of the machine, on Linux from /sys/devices/system/node.
+ * If the topology isn't available a single node with all cpus is returned.
+ * @return nodes sorted by id, each with at least one cpu
+ */
+[[nodiscard]] inline std::vector<NumaNode> readNumaTopology() {
+  auto result = std::vector<NumaNode>{};
+  const auto nodeDirectory = std::filesystem::path{"/sys/devices/system/node"};
+  auto errorCode = std::error_code{};
+  for (const auto &entry : std::filesystem::directory_iterator(nodeDirectory, errorCode)) {
+    const auto name = entry.path().filename().string();
+    if (!name.starts_with("node")) { continue; }
+    std::size_t id{};
+    if (const auto [ptr, ec] = std::from_chars(name.data() + 4, name.data() + name.size(), id);
+        ec != std::errc{} || ptr != name.data() + name.size()) {
+      continue;
+    }
+    auto file = std::ifstream{entry.path() / "cpulist"};
+    auto cpuList = std::string{};
+    if (!std::getline(file, cpuList)) { continue; }
+    if (auto cpus = details::parseCpuList(cpuList); cpus.has_value() && !cpus->empty()) {
+      result.emplace_back(NumaNode{id, std::move(*cpus)});
+    }
+  }
+  if (result.empty()) {
+    auto &node = result.emplace_back(NumaNode{0, {}});
+    node.cpus.resize(std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t i = 0; i < node.cpus.size(); ++i) { node.cpus[i] = i; }
+  }
+  std::ranges::sort(result, {}, &NumaNode::id);
+  return result;
+}
+
+/**
+ * Restrict a thread to given cpus.
+ * @param thread native handle of the thread
+ * @param cpus allowed cpus
+ * @return false if pinning failed or isn't supported on this platform
+ */
+inline bool pinThread(std::thread::native_handle_type thread, std::span<const std::size_t> cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) { CPU_SET(cpu, &set); }
+  }
+  return CPU_COUNT(&set) != 0 && pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+  (void) thread;
+  (void) cpus;
+  return false;
+#endif
+}
+
+/**
+ * Restrict the calling thread to given cpus.
+ * @param cpus allowed cpus
+ * @return false if pinning failed or isn't supported on this platform
+ */
+inline bool pinCurrentThread(std::span<const std::size_t> cpus) {
+#ifdef __linux__
+  return pinThread(pthread_self(), cpus);
+#else
+  (void) cpus;
+  return false;
+#endif
+}
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_CPUTOPOLOGY_H
@@ -0,0 +1,146 @@
+/**
+ * @file InplaceTask.h
+ * @brief Move only type erased callable with inline storage.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_INPLACETASK_H
+#define PF_COMMON_PARALLEL_INPLACETASK_H
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <pf_common/allocators/PoolAllocator.h>
+#include <type_traits>
+#include <utility>
+
+namespace pf {
+/**
+ * @brief Move only void() callable, a cheaper alternative to std::function/std::packaged_task for thread pool tasks.
+ *
+ * Callables up to InlineSize bytes with nothrow move constructor are stored inline, bigger ones are allocated through PoolAllocator.
+ * There are no virtual functions, dispatch goes through a static table of function pointers per callable type.
+ * @tparam InlineSize size of the inline storage in bytes
+ */
+template<std::size_t InlineSize = 64>
+class InplaceTask {
+  static_assert(InlineSize >= sizeof(void *), "Inline storage has to fit at least a pointer");
+
+ public:
+  /**
+   * Check whether a callable of type F is stored without any allocation.
+   */
+  template<typename F>
+  constexpr static bool isStoredInline =
+      sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+  InplaceTask() noexcept = default;
+
+  /**
+   * Construct InplaceTask from a callable.
+   * @param callable callable, its return value is discarded
+   */
+  template<std::invocable F>
+    requires(!std::same_as<std::remove_cvref_t<F>, InplaceTask>)
+  InplaceTask(F &&callable) {// NOLINT(google-explicit-constructor)
+    using Fn = std::decay_t<F>;
+    if constexpr (isStoredInline<Fn>) {
+      std::construct_at(reinterpret_cast<Fn *>(storage), std::forward<F>(callable));
+      ops = &inlineOps<Fn>;
+    } else {
+      auto allocator = PoolAllocator<Fn>{};
+      auto ptr = allocator.allocate(1);
+      try {
+        std::construct_at(ptr, std::forward<F>(callable));
+      } catch (...) {
+        allocator.deallocate(ptr, 1);
+        throw;
+      }
+      std::construct_at(reinterpret_cast<Fn **>(storage), ptr);
+      ops = &heapOps<Fn>;
+    }
+  }
+
+  InplaceTask(const InplaceTask &) = delete;
+  InplaceTask &operator=(const InplaceTask &) = delete;
+
+  InplaceTask(InplaceTask &&other) noexcept { takeFrom(other); }
+  InplaceTask &operator=(InplaceTask &&other) noexcept {
+    if (this != &other) {
+      reset();
+      takeFrom(other);
+    }
+    return *this;
+  }
+
+  ~InplaceTask() { reset(); }
+
+  /**
+   * Run the stored callable. The task must not be empty.
+   */
+  void operator()() { ops->invoke(storage); }
+
+  [[nodiscard]] explicit operator bool() const noexcept { return ops != nullptr; }
+
+  /**
+   * Destroy the stored callable.
+   */
+  void reset() noexcept {
+    if (ops != nullptr) {
+      ops->destroy(storage);
+      ops = nullptr;
+    }
+  }
+
+ private:
+  struct Operations {
+    void (*invoke)(std::byte *);
+    void (*moveAndDestroy)(std::byte *, std::byte *) noexcept;
+    void (*destroy)(std::byte *) noexcept;
+  };
+
+  template<typename Fn>
+  static Fn *inlineCallable(std::byte *data) {
+    return std::launder(reinterpret_cast<Fn *>(data));
+  }
+  template<typename Fn>
+  static Fn *&heapCallable(std::byte *data) {
+    return *std::launder(reinterpret_cast<Fn **>(data));
+  }
+
+  template<typename Fn>
+  constexpr static Operations inlineOps{
+      [](std::byte *data) { std::invoke(*inlineCallable<Fn>(data)); },
+      [](std::byte *dst, std::byte *src) noexcept {
+        std::construct_at(reinterpret_cast<Fn *>(dst), std::move(*inlineCallable<Fn>(src)));
+        std::destroy_at(inlineCallable<Fn>(src));
+      },
+      [](std::byte *data) noexcept { std::destroy_at(inlineCallable<Fn>(data)); }};
+
+  template<typename Fn>
+  constexpr static Operations heapOps{[](std::byte *data) { std::invoke(*heapCallable<Fn>(data)); },
+                                      [](std::byte *dst, std::byte *src) noexcept {
+                                        std::construct_at(reinterpret_cast<Fn **>(dst), heapCallable<Fn>(src));
+                                      },
+                                      [](std::byte *data) noexcept {
+                                        auto ptr = heapCallable<Fn>(data);
+                                        std::destroy_at(ptr);
+                                        PoolAllocator<Fn>{}.deallocate(ptr, 1);
+                                      }};
+
+  void takeFrom(InplaceTask &other) noexcept {
+    if (other.ops != nullptr) {
+      other.ops->moveAndDestroy(storage, other.storage);
+      ops = std::exchange(other.ops, nullptr);
+    }
+  }
+
+  alignas(std::max_align_t) std::byte storage[InlineSize];
+  const Operations *ops = nullptr;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_INPLACETASK_H
@@ -0,0 +1,290 @@
+/**
+ * @file MPMCQueue.h
+ * @brief Bounded lock-free multi producer multi consumer queue.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_MPMCQUEUE_H
+#define PF_COMMON_PARALLEL_MPMCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <pf_common/parallel/CacheLine.h>
+#include <type_traits>
+
+namespace pf {
+/**
+ * @brief Bounded multi producer multi consumer queue with the same interface as SafeQueue.
+ *
+ * Based on a ring buffer of cells with sequence numbers (D. Vyukov). Enqueue and dequeue are lock-free as long as the queue is neither
+ * full nor empty. Blocking operations spin for a short while and then sleep on a condition variable - the mutex is only touched when
+ * a thread has to sleep or when there is a sleeping thread to be woken up.
+ *
+ * After shutdown() all dequeue operations return std::nullopt and blocking enqueue operations return without inserting the item.
+ * @tparam T stored type
+ */
+template<typename T>
+class MPMCQueue {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  constexpr static size_type DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Construct MPMCQueue.
+   * @param capacity max item count, rounded up to a power of 2
+   */
+  explicit MPMCQueue(size_type capacity = DEFAULT_CAPACITY)
+      : mask(std::bit_ceil(std::max<size_type>(capacity, 2)) - 1), cells(std::make_unique<Cell[]>(mask + 1)) {
+    for (size_type i = 0; i <= mask; ++i) { cells[i].sequence.store(i, std::memory_order_relaxed); }
+  }
+  MPMCQueue(const MPMCQueue &) = delete;
+  MPMCQueue &operator=(const MPMCQueue &) = delete;
+  MPMCQueue(MPMCQueue &&) = delete;
+  MPMCQueue &operator=(MPMCQueue &&) = delete;
+
+  ~MPMCQueue() {
+    while (tryDequeueImpl().has_value()) {}
+  }
+
+  /**
+   * Add an item to the end of the queue, wait while the queue is full.
+   * @param item item to be added
+   */
+  void enqueue(T &&item) {
+    blockingEnqueue(std::move(item), [](auto &lock, auto &cv, auto pred) {
+      cv.wait(lock, pred);
+      return true;
+    });
+  }
+  /**
+   * Add an item to the end of the queue if there is space left.
+   * @param item item to be added, it's not moved from in case of failure
+   * @return true if the item was added
+   */
+  [[nodiscard]] bool tryEnqueue(T &&item) {
+    if (!keepRunning.load(std::memory_order_relaxed)) { return false; }
+    if (tryEnqueueImpl(item)) {
+      notifyConsumer();
+      return true;
+    }
+    return false;
+  }
+  /**
+   * Add an item to the end of the queue, wait for space until timeout expires.
+   * @param item item to be added, it's not moved from in case of failure
+   * @param timeout max wait duration
+   * @return true if the item was added
+   */
+  template<typename Rep, typename Period>
+  [[nodiscard]] bool enqueueFor(T &&item, std::chrono::duration<Rep, Period> timeout) {
+    return enqueueUntil(std::move(item), std::chrono::steady_clock::now() + timeout);
+  }
+  /**
+   * Add an item to the end of the queue, wait for space until deadline.
+   * @param item item to be added, it's not moved from in case of failure
+   * @param deadline wait deadline
+   * @return true if the item was added
+   */
+  template<typename Clock, typename Duration>
+  [[nodiscard]] bool enqueueUntil(T &&item, std::chrono::time_point<Clock, Duration> deadline) {
+    return blockingEnqueue(std::move(item),
+                           [deadline](auto &lock, auto &cv, auto pred) { return cv.wait_until(lock, deadline, pred); });
+  }
+
+  /**
+   * Take an item from the front of the queue, wait while the queue is empty.
+   * @return item or std::nullopt if the queue was shut down
+   */
+  [[nodiscard]] std::optional<T> dequeue() {
+    return blockingDequeue([](auto &lock, auto &cv, auto pred) {
+      cv.wait(lock, pred);
+      return true;
+    });
+  }
+  /**
+   * Take an item from the front of the queue if there is any.
+   * @return item or std::nullopt if the queue is empty or was shut down
+   */
+  [[nodiscard]] std::optional<T> tryDequeue() {
+    if (!keepRunning.load(std::memory_order_relaxed)) { return std::nullopt; }
+    auto result = tryDequeueImpl();
+    if (result.has_value()) { notifyProducer(); }
+    return result;
+  }
+  /**
+   * Take an item from the front of the queue, wait for an item until timeout expires.
+   * @param timeout max wait duration
+   * @return item or std::nullopt if the queue was empty or was shut down
+   */
+  template<typename Rep, typename Period>
+  [[nodiscard]] std::optional<T> dequeueFor(std::chrono::duration<Rep, Period> timeout) {
+    return dequeueUntil(std::chrono::steady_clock::now() + timeout);
+  }
+  /**
+   * Take an item from the front of the queue, wait for an item until deadline.
+   * @param deadline wait deadline
+   * @return item or std::nullopt if the queue was empty or was shut down
+   */
+  template<typename Clock, typename Duration>
+  [[nodiscard]] std::optional<T> dequeueUntil(std::chrono::time_point<Clock, Duration> deadline) {
+    return blockingDequeue([deadline](auto &lock, auto &cv, auto pred) { return cv.wait_until(lock, deadline, pred); });
+  }
+
+  /**
+   * Wake up all waiting threads, further dequeues return std::nullopt.
+   */
+  void shutdown() {
+    {
+      std::lock_guard lock{mtx};
+      keepRunning = false;
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+  }
+
+  /**
+   * @return approximate item count
+   */
+  [[nodiscard]] size_type size() const {
+    const auto head = dequeuePos.load(std::memory_order_relaxed);
+    const auto tail = enqueuePos.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+  [[nodiscard]] bool isEmpty() const { return size() == 0; }
+  [[nodiscard]] size_type capacity() const { return mask + 1; }
+
+ private:
+  constexpr static unsigned SPIN_COUNT = 64;
+
+  struct alignas(CACHE_LINE_SIZE) Cell {
+    std::atomic<size_type> sequence;
+    alignas(T) std::byte storage[sizeof(T)];
+
+    T *data() { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> enqueuePos = 0;
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> dequeuePos = 0;
+  alignas(CACHE_LINE_SIZE) const size_type mask;
+  std::unique_ptr<Cell[]> cells;
+  std::atomic<bool> keepRunning = true;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> waitingConsumers = 0;
+  std::atomic<size_type> waitingProducers = 0;
+  std::mutex mtx;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+
+  bool tryEnqueueImpl(T &item) {
+    auto pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      auto &cell = cells[pos & mask];
+      const auto seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::make_signed_t<size_type>>(seq - pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          std::construct_at(reinterpret_cast<T *>(cell.storage), std::move(item));
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::optional<T> tryDequeueImpl() {
+    auto pos = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      auto &cell = cells[pos & mask];
+      const auto seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::make_signed_t<size_type>>(seq - (pos + 1));
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          auto result = std::optional<T>{std::move(*cell.data())};
+          std::destroy_at(cell.data());
+          cell.sequence.store(pos + mask + 1, std::memory_order_release);
+          return result;
+        }
+      } else if (diff < 0) {
+        return std::nullopt;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void notifyConsumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitingConsumers.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard lock{mtx};
+      notEmpty.notify_one();
+    }
+  }
+  void notifyProducer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitingProducers.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard lock{mtx};
+      notFull.notify_one();
+    }
+  }
+
+  bool blockingEnqueue(T &&item, auto wait) {
+    for (unsigned i = 0; i < SPIN_COUNT; ++i) {
+      if (!keepRunning.load(std::memory_order_relaxed)) { return false; }
+      if (tryEnqueueImpl(item)) {
+        notifyConsumer();
+        return true;
+      }
+    }
+    auto enqueued = false;
+    {
+      std::unique_lock lock{mtx};
+      waitingProducers.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      wait(lock, notFull, [&] { return !keepRunning.load(std::memory_order_relaxed) || (enqueued = tryEnqueueImpl(item)); });
+      waitingProducers.fetch_sub(1);
+    }
+    if (enqueued) { notifyConsumer(); }
+    return enqueued;
+  }
+
+  std::optional<T> blockingDequeue(auto wait) {
+    for (unsigned i = 0; i < SPIN_COUNT; ++i) {
+      if (!keepRunning.load(std::memory_order_relaxed)) { return std::nullopt; }
+      if (auto result = tryDequeueImpl(); result.has_value()) {
+        notifyProducer();
+        return result;
+      }
+    }
+    auto result = std::optional<T>{};
+    {
+      std::unique_lock lock{mtx};
+      waitingConsumers.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      wait(lock, notEmpty, [&] {
+        if (!keepRunning.load(std::memory_order_relaxed)) { return true; }
+        result = tryDequeueImpl();
+        return result.has_value();
+      });
+      waitingConsumers.fetch_sub(1);
+    }
+    if (result.has_value()) { notifyProducer(); }
+    return result;
+  }
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_MPMCQUEUE_H
@@ -0,0 +1,220 @@
+/**
+ * @file SPSCQueue.h
+ * @brief Wait-free single producer single consumer ring buffer.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_SPSCQUEUE_H
+#define PF_COMMON_PARALLEL_SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <pf_common/parallel/CacheLine.h>
+#include <span>
+#include <thread>
+#include <type_traits>
+
+namespace pf {
+/**
+ * @brief Bounded queue for exactly one producer thread and one consumer thread.
+ *
+ * All try operations are wait-free. Each side keeps a cached copy of the other side's index on its own cache line, so the shared indices
+ * are only read when the cached value says the queue is full/empty. Batch operations publish all items with a single store and use
+ * memcpy for trivially copyable types.
+ *
+ * Blocking operations don't put any cost on the other side - they spin, then yield and then sleep for short periods, so they are meant
+ * for consumers which are busy most of the time.
+ * @tparam T stored type
+ */
+template<typename T>
+class SPSCQueue {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  constexpr static size_type DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Construct SPSCQueue.
+   * @param capacity max item count, rounded up to a power of 2
+   */
+  explicit SPSCQueue(size_type capacity = DEFAULT_CAPACITY)
+      : mask(std::bit_ceil(std::max<size_type>(capacity, 2)) - 1), storage(std::make_unique<Storage[]>(mask + 1)) {}
+  SPSCQueue(const SPSCQueue &) = delete;
+  SPSCQueue &operator=(const SPSCQueue &) = delete;
+  SPSCQueue(SPSCQueue &&) = delete;
+  SPSCQueue &operator=(SPSCQueue &&) = delete;
+
+  ~SPSCQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const auto end = writeIndex.load(std::memory_order_relaxed);
+      for (auto i = readIndex.load(std::memory_order_relaxed); i != end; ++i) { std::destroy_at(slot(i)); }
+    }
+  }
+
+  /**
+   * Add an item to the end of the queue if there is space. Producer only.
+   * @param item item to be added, it's not moved from in case of failure
+   * @return true if the item was added
+   */
+  [[nodiscard]] bool tryEnqueue(T &&item) {
+    const auto write = writeIndex.load(std::memory_order_relaxed);
+    if (write - cachedReadIndex > mask) {
+      cachedReadIndex = readIndex.load(std::memory_order_acquire);
+      if (write - cachedReadIndex > mask) { return false; }
+    }
+    std::construct_at(reinterpret_cast<T *>(storage[write & mask].data), std::move(item));
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+  }
+  /**
+   * Add items to the end of the queue, as many as fit. Producer only.
+   * @param items items to be copied into the queue
+   * @return count of added items, always a prefix of items
+   */
+  [[nodiscard]] size_type tryEnqueueBatch(std::span<const T> items)
+    requires std::is_copy_constructible_v<T>
+  {
+    const auto write = writeIndex.load(std::memory_order_relaxed);
+    auto freeSpace = capacity() - (write - cachedReadIndex);
+    if (freeSpace < items.size()) {
+      cachedReadIndex = readIndex.load(std::memory_order_acquire);
+      freeSpace = capacity() - (write - cachedReadIndex);
+    }
+    const auto count = std::min(freeSpace, items.size());
+    if (count == 0) { return 0; }
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      const auto firstPart = std::min(count, capacity() - (write & mask));
+      std::memcpy(storage[write & mask].data, items.data(), firstPart * sizeof(T));
+      std::memcpy(storage[0].data, items.data() + firstPart, (count - firstPart) * sizeof(T));
+    } else {
+      for (size_type i = 0; i < count; ++i) { std::construct_at(reinterpret_cast<T *>(storage[(write + i) & mask].data), items[i]); }
+    }
+    writeIndex.store(write + count, std::memory_order_release);
+    return count;
+  }
+  /**
+   * Add an item to the end of the queue, wait while the queue is full. Producer only.
+   * @param item item to be added
+   * @return false if the queue was shut down before the item could be added
+   */
+  bool enqueue(T &&item) {
+    return waitFor([&] { return tryEnqueue(std::move(item)); });
+  }
+
+  /**
+   * Take an item from the front of the queue if there is any. Consumer only.
+   * @return item or std::nullopt if the queue is empty
+   */
+  [[nodiscard]] std::optional<T> tryDequeue() {
+    const auto read = readIndex.load(std::memory_order_relaxed);
+    if (read == cachedWriteIndex) {
+      cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+      if (read == cachedWriteIndex) { return std::nullopt; }
+    }
+    auto item = slot(read);
+    auto result = std::optional<T>{std::move(*item)};
+    std::destroy_at(item);
+    readIndex.store(read + 1, std::memory_order_release);
+    return result;
+  }
+  /**
+   * Take items from the front of the queue, as many as are available and fit to out. Consumer only.
+   * @param out destination for the items, items are move assigned into it
+   * @return count of items written to the beginning of out
+   */
+  [[nodiscard]] size_type tryDequeueBatch(std::span<T> out) {
+    const auto read = readIndex.load(std::memory_order_relaxed);
+    auto available = cachedWriteIndex - read;
+    if (available < out.size()) {
+      cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+      available = cachedWriteIndex - read;
+    }
+    const auto count = std::min(available, out.size());
+    if (count == 0) { return 0; }
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      const auto firstPart = std::min(count, capacity() - (read & mask));
+      std::memcpy(out.data(), storage[read & mask].data, firstPart * sizeof(T));
+      std::memcpy(out.data() + firstPart, storage[0].data, (count - firstPart) * sizeof(T));
+    } else {
+      for (size_type i = 0; i < count; ++i) {
+        auto item = slot(read + i);
+        out[i] = std::move(*item);
+        std::destroy_at(item);
+      }
+    }
+    readIndex.store(read + count, std::memory_order_release);
+    return count;
+  }
+  /**
+   * Take an item from the front of the queue, wait while the queue is empty. Consumer only.
+   * @return item or std::nullopt if the queue was shut down
+   */
+  [[nodiscard]] std::optional<T> dequeue() {
+    auto result = std::optional<T>{};
+    waitFor([&] {
+      result = tryDequeue();
+      return result.has_value();
+    });
+    return result;
+  }
+
+  /**
+   * Make blocking operations return.
+   */
+  void shutdown() { keepRunning.store(false, std::memory_order_relaxed); }
+
+  /**
+   * @return approximate item count
+   */
+  [[nodiscard]] size_type size() const {
+    const auto read = readIndex.load(std::memory_order_acquire);
+    return writeIndex.load(std::memory_order_acquire) - read;
+  }
+  [[nodiscard]] bool isEmpty() const { return size() == 0; }
+  [[nodiscard]] size_type capacity() const { return mask + 1; }
+
+ private:
+  struct Storage {
+    alignas(T) std::byte data[sizeof(T)];
+  };
+
+  T *slot(size_type index) { return std::launder(reinterpret_cast<T *>(storage[index & mask].data)); }
+
+  bool waitFor(std::predicate auto &&tryOperation) {
+    constexpr auto SPIN_COUNT = 1024u;
+    constexpr auto YIELD_COUNT = 64u;
+    constexpr auto SLEEP_DURATION = std::chrono::microseconds{50};
+    for (auto i = 0u; keepRunning.load(std::memory_order_relaxed); ++i) {
+      if (tryOperation()) { return true; }
+      if (i >= SPIN_COUNT + YIELD_COUNT) {
+        std::this_thread::sleep_for(SLEEP_DURATION);
+      } else if (i >= SPIN_COUNT) {
+        std::this_thread::yield();
+      }
+    }
+    return false;
+  }
+
+  // producer
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> writeIndex = 0;
+  size_type cachedReadIndex = 0;
+  // consumer
+  alignas(CACHE_LINE_SIZE) std::atomic<size_type> readIndex = 0;
+  size_type cachedWriteIndex = 0;
+  // shared, read only
+  alignas(CACHE_LINE_SIZE) const size_type mask;
+  std::unique_ptr<Storage[]> storage;
+  std::atomic<bool> keepRunning = true;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_SPSCQUEUE_H
@@ -6,16 +6,62 @@
 #define PF_COMMON_PARALLEL_SAFE_H
 
 #include <mutex>
+#include <shared_mutex>
+#include <type_traits>
 
 namespace pf {
+/**
+ * Mutex supporting shared ownership, e.g. std::shared_mutex.
+ */
+template<typename M>
+concept SharedLockable = requires(M mtx) {
+  mtx.lock_shared();
+  mtx.unlock_shared();
+  { mtx.try_lock_shared() } -> std::convertible_to<bool>;
+};
+
+/**
+ * Lock whose readers copy the protected data instead of locking, e.g. SeqLock.
+ */
+template<typename M, typename T>
+concept SequenceLockable = requires(const M mtx, const T &value) {
+  { mtx.read(value) } -> std::same_as<T>;
+};
+
+namespace details {
+template<typename Mutex>
+struct NoLock {
+  explicit NoLock(Mutex &) noexcept {}
+};
+
+/**
+ * Trivially copyable type used to detect sequence locks regardless of the protected type.
+ */
+struct SequenceLockProbe {
+  int value;
+};
+}// namespace details
+
+/**
+ * Lock whose readers copy the protected data instead of locking for any trivially copyable type, e.g. SeqLock.
+ */
+template<typename M>
+concept SequenceLock = SequenceLockable<M, details::SequenceLockProbe>;
 
 /**
  * @brief Wrapper class for safe access for objects which are not thread safe.
+ *
+ * Read only access takes shared ownership when Mutex is SharedLockable (std::shared_mutex), so readers don't block each other.
+ * With SeqLock as Mutex read only access doesn't lock at all, it holds a consistent copy of the value instead. T has to be trivially
+ * copyable in that case.
  * @tparam T protected type
  * @tparam Mutex mutex used for access locking
  */
 template<typename T, typename Mutex = std::mutex>
 class Safe final {
+  static_assert(!SequenceLock<Mutex> || std::is_trivially_copyable_v<T>,
+                "Readers of a sequence lock copy the data, use a trivially copyable type or another mutex");
+
  public:
   /**
    * Type of access to data.
@@ -46,7 +92,7 @@ class Safe final {
    * @param args arguments forwarded to constructor
    */
   template<typename... Args>
-  explicit Safe(Args &&...args) : value(std::forward<Args &&...>(args)...) {}
+  explicit Safe(Args &&...args) : value(std::forward<Args>(args)...) {}
   /**
    * Inplace construction of protected value.
    * @tparam Args argument types for construction
@@ -54,12 +100,11 @@ class Safe final {
    * @param args arguments forwarded to constructor
    */
   template<typename... Args>
-  explicit Safe(Mutex &&mtx, Args &&...args) : mtx(std::move(mtx)), value(std::forward<Args &&...>(args)...) {}
-  Safe(const Safe &other) : value(other.value), mtx(std::mutex{}) {}
+  explicit Safe(Mutex &&mtx, Args &&...args) : mtx(std::move(mtx)), value(std::forward<Args>(args)...) {}
+  Safe(const Safe &other) : mtx(), value(other.value) {}
   Safe &operator=(const Safe &other) {
     if (this == &other) { return *this; }
     value = other.value;
-    mtx = std::mutex{};
     return *this;
   }
   Safe(Safe &&other) = delete;
@@ -121,11 +166,16 @@ class Safe final {
 
   template<AccessType AccessPolicy>
   class Access final {
-    using reference_type = std::conditional_t<AccessPolicy == Safe<T>::AccessType::ReadWrite, reference, const_reference>;
-    using pointer_type = std::conditional_t<AccessPolicy == Safe<T>::AccessType::ReadWrite, pointer, const_pointer>;
+    constexpr static bool isReadOnly = AccessPolicy == AccessType::ReadOnly;
+    constexpr static bool isSequenceRead = isReadOnly && SequenceLockable<Mutex, T>;
+    using reference_type = std::conditional_t<isReadOnly, const_reference, reference>;
+    using pointer_type = std::conditional_t<isReadOnly, const_pointer, pointer>;
+    using storage_type = std::conditional_t<isSequenceRead, const value_type, reference_type>;
+    using lock_type = std::conditional_t<isSequenceRead, details::NoLock<Mutex>,
+                                         std::conditional_t<isReadOnly && SharedLockable<Mutex>, std::shared_lock<Mutex>, std::unique_lock<Mutex>>>;
 
    public:
-    Access(reference_type value, Mutex &mtx) : value(value), lck(mtx) {}
+    Access(reference_type value, Mutex &mtx) : lck(mtx), value(load(value, mtx)) {}
     explicit Access(Safe<T, Mutex> &safe) : Access(safe.value, safe.mtx) {}
     Access(const Access &other) = delete;
     Access(Access &&other) = delete;
@@ -138,8 +188,16 @@ class Safe final {
     const_pointer operator->() const noexcept { return &value; }
 
    private:
-    reference_type value;
-    std::unique_lock<Mutex> lck;
+    static storage_type load(reference_type value, Mutex &mtx) {
+      if constexpr (isSequenceRead) {
+        return mtx.read(value);
+      } else {
+        return value;
+      }
+    }
+
+    lock_type lck;
+    storage_type value;
   };
 
  private:
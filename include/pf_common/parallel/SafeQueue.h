@@ -8,74 +8,226 @@
 #ifndef PF_COMMON_PARALLEL_SAFEQUEUE_H
 #define PF_COMMON_PARALLEL_SAFEQUEUE_H
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <concepts>
 #include <condition_variable>
+#include <cstddef>
+#include <limits>
 #include <mutex>
+#include <optional>
+#include <pf_common/parallel/SpinMutex.h>
 #include <queue>
+#include <ranges>
+#include <span>
+#include <type_traits>
 
 namespace pf {
 /**
 * @brief A template queue to pass data between threads - thread safe
+* @tparam T stored type
+* @tparam Mutex mutex used for access locking, std::condition_variable_any is used for other than std::mutex
+*
+* Blocking dequeue operations can spin for a while before going to sleep on the condition variable, see setSpinCount().
+* Spinning only reads an atomic item count so it doesn't slow down producers.
 */
-template<typename T>
+template<typename T, typename Mutex = std::mutex>
 class SafeQueue {
+  using condition_variable =
+      std::conditional_t<std::same_as<Mutex, std::mutex>, std::condition_variable, std::condition_variable_any>;
+
  public:
   SafeQueue() : keep_running(true){};
   SafeQueue(SafeQueue &&other) noexcept {
     queue = std::move(other.queue);
     keep_running = other.keep_running;
+    spinCount = other.spinCount;
+    updateItemCount();
   }
   SafeQueue &operator=(SafeQueue &&other) noexcept {
     queue = std::move(other.queue);
     keep_running = other.keep_running;
+    spinCount = other.spinCount;
+    updateItemCount();
     return *this;
   }
   /**
+  * Set count of checks for new items done by blocking dequeue operations before the thread goes to sleep. Spinning lowers latency of
+  * a hot consumer at the cost of cpu time, it's disabled by default.
+  * @param count count of checks, each one is followed by a cpu pause
+  */
+  void setSpinCount(std::size_t count) { spinCount = count; }
+  [[nodiscard]] std::size_t getSpinCount() const { return spinCount; }
+  /**
   * Add an item to the end of the queue
   * @param item item to be added
   */
   void enqueue(T &&item) {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    bool wasEmpty = queue.empty();
-
+    std::unique_lock<Mutex> lock(queueMutex);
     queue.push(std::forward<T>(item));
+    updateItemCount();
+    // a waiting thread might not have been woken up by the previous item yet, notifying only on empty queue would lose a wake up
+    const auto anyWaiting = waitingCount != 0;
     lock.unlock();
 
-    if (wasEmpty) conditionVariable.notify_one();
+    if (anyWaiting) conditionVariable.notify_one();
+  }
+  /**
+  * Add all items of a range to the end of the queue with a single lock, wake up as many waiting threads as there are new items.
+  * @param items items to be added, they are moved from
+  */
+  template<std::ranges::input_range R>
+  void enqueueRange(R &&items) {
+    std::unique_lock<Mutex> lock(queueMutex);
+    std::size_t count = 0;
+    for (auto &&item : items) {
+      queue.push(std::move(item));
+      ++count;
+    }
+    updateItemCount();
+    const auto waiting = waitingCount;
+    lock.unlock();
+
+    if (count >= waiting) {
+      conditionVariable.notify_all();
+    } else {
+      for (std::size_t i = 0; i < count; ++i) { conditionVariable.notify_one(); }
+    }
   }
 
   [[nodiscard]] std::optional<T> dequeue() {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    while (keep_running && queue.empty()) { conditionVariable.wait(lock); }
+    spinForItems();
+    std::unique_lock<Mutex> lock(queueMutex);
+    while (keep_running && queue.empty()) {
+      ++waitingCount;
+      conditionVariable.wait(lock);
+      --waitingCount;
+    }
+    return popFront();
+  }
+  /**
+  * Dequeue an item if there is one, never waits.
+  * @return item or std::nullopt if the queue is empty or was shut down
+  */
+  [[nodiscard]] std::optional<T> tryDequeue() {
+    if (itemCount.load(std::memory_order_relaxed) == 0) { return std::nullopt; }
+    std::unique_lock<Mutex> lock(queueMutex);
+    return popFront();
+  }
+  /**
+  * Wait for an item until timeout passes.
+  * @param timeout maximum wait time
+  * @return item or std::nullopt on timeout or shutdown
+  */
+  template<typename Rep, typename Period>
+  [[nodiscard]] std::optional<T> dequeueFor(const std::chrono::duration<Rep, Period> &timeout) {
+    return dequeueUntil(std::chrono::steady_clock::now() + timeout);
+  }
+  /**
+  * Wait for an item until deadline.
+  * @param deadline time point after which the wait is ended
+  * @return item or std::nullopt on timeout or shutdown
+  */
+  template<typename Clock, typename Duration>
+  [[nodiscard]] std::optional<T> dequeueUntil(const std::chrono::time_point<Clock, Duration> &deadline) {
+    spinForItems();
+    std::unique_lock<Mutex> lock(queueMutex);
+    while (keep_running && queue.empty()) {
+      ++waitingCount;
+      const auto status = conditionVariable.wait_until(lock, deadline);
+      --waitingCount;
+      if (status == std::cv_status::timeout) { break; }
+    }
+    return popFront();
+  }
+  /**
+  * Wait for items and move as many of them as fit into out with a single lock.
+  * @param out destination for dequeued items
+  * @return count of items written to the beginning of out, 0 when the queue was shut down or out is empty
+  */
+  [[nodiscard]] std::size_t dequeueBatch(std::span<T> out) {
+    if (out.empty()) { return 0; }
+    spinForItems();
+    std::unique_lock<Mutex> lock(queueMutex);
+    while (keep_running && queue.empty()) {
+      ++waitingCount;
+      conditionVariable.wait(lock);
+      --waitingCount;
+    }
 
-    if (keep_running && !queue.empty()) {
-      auto item = std::move(queue.front());
+    if (!keep_running) { return 0; }
+    const auto count = std::min(out.size(), queue.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = std::move(queue.front());
       queue.pop();
-      return item;
     }
-    return std::nullopt;
+    updateItemCount();
+    return count;
+  }
+  /**
+  * Move items which are currently in the queue to the end of a container with a single lock, doesn't wait for new items.
+  * @param container destination container, items are appended using push_back
+  * @param maxCount maximum count of moved items
+  * @return count of moved items
+  */
+  template<typename Container>
+    requires requires(Container &container, T &&item) { container.push_back(std::move(item)); }
+  std::size_t drainInto(Container &container, std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+    std::unique_lock<Mutex> lock(queueMutex);
+    const auto count = std::min(maxCount, queue.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      container.push_back(std::move(queue.front()));
+      queue.pop();
+    }
+    updateItemCount();
+    return count;
   }
 
   bool isEmpty() {
-    std::unique_lock<std::mutex> lock(queueMutex);
+    std::unique_lock<Mutex> lock(queueMutex);
     return queue.empty();
   }
 
   void shutdown() {
-    keep_running = false;
+    {
+      std::lock_guard<Mutex> lock(queueMutex);
+      keep_running = false;
+    }
     conditionVariable.notify_all();
   }
 
   [[nodiscard]] std::size_t size() {
-    std::unique_lock<std::mutex> lock(queueMutex);
+    std::unique_lock<Mutex> lock(queueMutex);
     return queue.size();
   }
 
  private:
-  std::mutex queueMutex;
-  std::condition_variable conditionVariable;
+  /**
+  * Pop the first item, queueMutex has to be locked.
+  */
+  [[nodiscard]] std::optional<T> popFront() {
+    if (!keep_running || queue.empty()) { return std::nullopt; }
+    auto item = std::move(queue.front());
+    queue.pop();
+    updateItemCount();
+    return item;
+  }
+  void updateItemCount() { itemCount.store(queue.size(), std::memory_order_relaxed); }
+  void spinForItems() const {
+    for (std::size_t i = 0; i < spinCount; ++i) {
+      if (itemCount.load(std::memory_order_relaxed) != 0 || !keep_running.load(std::memory_order_relaxed)) { return; }
+      details::cpuPause();
+    }
+  }
+
+  Mutex queueMutex;
+  condition_variable conditionVariable;
   std::queue<T> queue;
   std::atomic<bool> keep_running;
+  std::size_t waitingCount = 0;
+  std::atomic<std::size_t> itemCount = 0;
+  std::size_t spinCount = 0;
 };
 }// namespace pf
 #endif// PF_COMMON_PARALLEL_SAFEQUEUE_H
\ No newline at end of file
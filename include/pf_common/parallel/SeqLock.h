@@ -0,0 +1,70 @@
+/**
+ * @file SeqLock.h
+ * @brief Sequence lock for read mostly trivially copyable data.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_SEQLOCK_H
+#define PF_COMMON_PARALLEL_SEQLOCK_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace pf {
+/**
+ * @brief Sequence lock - writers are exclusive, readers copy the data optimistically and retry if a write happened meanwhile.
+ *
+ * Readers never write to shared memory, so they don't fight over a cache line like with a mutex or a shared_mutex. Satisfies Lockable
+ * requirements for writers. When used as Safe's Mutex, read only accesses hold a consistent copy of the data instead of locking.
+ */
+class SeqLock {
+ public:
+  SeqLock() = default;
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  void lock() noexcept {
+    while (!try_lock()) { std::this_thread::yield(); }
+  }
+  [[nodiscard]] bool try_lock() noexcept {
+    auto current = sequence.load(std::memory_order_relaxed);
+    if ((current & 1) != 0 || !sequence.compare_exchange_strong(current, current + 1, std::memory_order_acquire)) { return false; }
+    // data written by the writer must not become visible before the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+  void unlock() noexcept { sequence.fetch_add(1, std::memory_order_release); }
+
+  /**
+   * Copy value written under this lock, retry until the copy isn't interleaved with a write.
+   * @param value value protected by this lock
+   * @return consistent copy of value
+   */
+  template<typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] T read(const T &value) const noexcept {
+    auto buffer = std::array<std::byte, sizeof(T)>{};
+    while (true) {
+      const auto before = sequence.load(std::memory_order_acquire);
+      if ((before & 1) != 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::memcpy(buffer.data(), &value, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) { return std::bit_cast<T>(buffer); }
+    }
+  }
+
+ private:
+  std::atomic<std::size_t> sequence = 0;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_SEQLOCK_H
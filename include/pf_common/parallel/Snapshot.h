@@ -0,0 +1,159 @@
+/**
+ * @file Snapshot.h
+ * @brief RCU like container for read mostly shared state.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_SNAPSHOT_H
+#define PF_COMMON_PARALLEL_SNAPSHOT_H
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pf_common/macros.h>
+#include <pf_common/parallel/CacheLine.h>
+#include <utility>
+
+namespace pf {
+namespace details {
+/**
+ * @brief Atomically replaced std::shared_ptr. Uses std::atomic<std::shared_ptr> where the standard library has it, otherwise the atomic
+ * free functions for std::shared_ptr (e.g. libstdc++ before GCC 12).
+ */
+template<typename T>
+class AtomicSharedPtr {
+ public:
+  explicit AtomicSharedPtr(std::shared_ptr<T> value) : value(std::move(value)) {}
+
+#ifdef __cpp_lib_atomic_shared_ptr
+  [[nodiscard]] std::shared_ptr<T> load(std::memory_order order) const { return value.load(order); }
+  void store(std::shared_ptr<T> newValue, std::memory_order order) { value.store(std::move(newValue), order); }
+
+ private:
+  std::atomic<std::shared_ptr<T>> value;
+#else
+#if !PF_MSVC
+// the free functions are deprecated in C++20, but they are the only option here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  [[nodiscard]] std::shared_ptr<T> load(std::memory_order order) const { return std::atomic_load_explicit(&value, order); }
+  void store(std::shared_ptr<T> newValue, std::memory_order order) { std::atomic_store_explicit(&value, std::move(newValue), order); }
+#if !PF_MSVC
+#pragma GCC diagnostic pop
+#endif
+
+ private:
+  std::shared_ptr<T> value;
+#endif
+};
+}// namespace details
+
+/**
+ * @brief Holder of an immutable value which is replaced as a whole (read-copy-update).
+ *
+ * Readers get a reference counted snapshot and can keep using it for as long as they like, even after a newer version was published.
+ * Writers build a new version and publish it atomically, old versions are destroyed when the last reader releases them. Writers are
+ * serialized by a mutex which readers never touch.
+ *
+ * load() is not lock-free on every standard library - the atomic shared pointer of libstdc++ is guarded by a lock, either inside
+ * std::atomic<std::shared_ptr> or, before GCC 12, a global lock table of the atomic free functions - and it always writes the shared
+ * reference count. Readers which need lock-free reads without contention should use
+ * Reader, which caches the snapshot and only checks a version counter, so in steady state it doesn't write to any shared memory
+ * and calls load() only after a new version was published.
+ * @tparam T stored type
+ */
+template<typename T>
+class Snapshot {
+ public:
+  using value_type = T;
+  using pointer = std::shared_ptr<const T>;
+
+  /**
+   * @brief Cached reader of a Snapshot, meant to be owned by a single thread.
+   */
+  class Reader {
+   public:
+    explicit Reader(const Snapshot &snapshot) : snapshot(&snapshot) {}
+
+    /**
+     * @return the latest published version, valid until the next call of get()
+     */
+    [[nodiscard]] const T &get() {
+      if (const auto currentVersion = snapshot->version.load(std::memory_order_acquire); currentVersion != version || !cached) {
+        version = currentVersion;
+        cached = snapshot->load();
+      }
+      return *cached;
+    }
+    [[nodiscard]] const T &operator*() { return get(); }
+    [[nodiscard]] const T *operator->() { return &get(); }
+
+   private:
+    const Snapshot *snapshot;
+    pointer cached;
+    std::uint64_t version = 0;
+  };
+
+  /**
+   * Inplace construction of the initial value.
+   * @param args arguments forwarded to constructor
+   */
+  template<typename... Args>
+    requires std::constructible_from<T, Args...>
+  explicit Snapshot(Args &&...args) : current(std::make_shared<const T>(std::forward<Args>(args)...)) {}
+  Snapshot(const Snapshot &) = delete;
+  Snapshot &operator=(const Snapshot &) = delete;
+
+  /**
+   * @return the latest published version
+   */
+  [[nodiscard]] pointer load() const { return current.load(std::memory_order_acquire); }
+
+  /**
+   * Publish a new version.
+   * @param value new value
+   */
+  void store(T value) { store(std::make_shared<const T>(std::move(value))); }
+  /**
+   * Publish a new version.
+   * @param value new value, must not be null
+   */
+  void store(pointer value) {
+    std::lock_guard lock{writeMutex};
+    publish(std::move(value));
+  }
+
+  /**
+   * Copy the latest version, modify the copy and publish it. Concurrent updates are serialized, none of them is lost.
+   * @param fnc modification of the copy
+   */
+  void update(std::invocable<T &> auto &&fnc) {
+    std::lock_guard lock{writeMutex};
+    auto copy = std::make_shared<T>(*current.load(std::memory_order_relaxed));
+    std::invoke(fnc, *copy);
+    publish(std::move(copy));
+  }
+
+  /**
+   * Create a cached reader of this Snapshot.
+   */
+  [[nodiscard]] Reader reader() const { return Reader{*this}; }
+
+ private:
+  void publish(pointer value) {
+    current.store(std::move(value), std::memory_order_release);
+    version.fetch_add(1, std::memory_order_release);
+  }
+
+  details::AtomicSharedPtr<const T> current;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> version = 0;
+  std::mutex writeMutex;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_SNAPSHOT_H
@@ -0,0 +1,75 @@
+/**
+ * @file SpinMutex.h
+ * @brief Test and test-and-set spin lock with exponential backoff.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_SPINMUTEX_H
+#define PF_COMMON_PARALLEL_SPINMUTEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <pf_common/macros.h>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#elif PF_MSVC && (defined(_M_ARM) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace pf {
+namespace details {
+/**
+ * Hint to the cpu that this is a spin wait loop.
+ */
+PF_FORCEINLINE void cpuPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  _mm_pause();
+#elif PF_MSVC && (defined(_M_ARM) || defined(_M_ARM64))
+  __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+}// namespace details
+
+/**
+ * @brief Spin lock for very short critical sections, satisfies Lockable requirements.
+ *
+ * Waiting threads only read the lock until it's released (test and test-and-set), so they don't steal the cache line from the owner.
+ * Pause count between checks doubles up to MAX_BACKOFF, after that the waiting thread yields on each check.
+ */
+class SpinMutex {
+ public:
+  constexpr static unsigned MAX_BACKOFF = 64;
+
+  SpinMutex() = default;
+  SpinMutex(const SpinMutex &) = delete;
+  SpinMutex &operator=(const SpinMutex &) = delete;
+
+  void lock() noexcept {
+    auto backoff = 1u;
+    while (locked.exchange(true, std::memory_order_acquire)) {
+      do {
+        if (backoff < MAX_BACKOFF) {
+          for (auto i = 0u; i < backoff; ++i) { details::cpuPause(); }
+          backoff *= 2;
+        } else {
+          std::this_thread::yield();
+        }
+      } while (locked.load(std::memory_order_relaxed));
+    }
+  }
+  [[nodiscard]] bool try_lock() noexcept {
+    return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+  }
+  void unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic<bool> locked = false;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_SPINMUTEX_H
@@ -0,0 +1,425 @@
+/**
+ * @file Task.h
+ * @brief Lazily started coroutine task and its combinators.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_TASK_H
+#define PF_COMMON_PARALLEL_TASK_H
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <latch>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace pf {
+template<typename T>
+class Task;
+
+namespace details {
+struct TaskPromiseBase {
+  struct FinalAwaiter {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    template<typename Promise>
+    [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      return handle.promise().continuation;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+  [[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+  void rethrowIfFailed() const {
+    if (exception != nullptr) { std::rethrow_exception(exception); }
+  }
+
+  std::coroutine_handle<> continuation = std::noop_coroutine();
+  std::exception_ptr exception;
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+  [[nodiscard]] pf::Task<T> get_return_object() noexcept;
+
+  template<typename U>
+    requires std::constructible_from<T, U &&>
+  void return_value(U &&result) {
+    value.emplace(std::forward<U>(result));
+  }
+
+  [[nodiscard]] T &result() & {
+    rethrowIfFailed();
+    return *value;
+  }
+  [[nodiscard]] T result() && {
+    rethrowIfFailed();
+    return std::move(*value);
+  }
+
+  std::optional<T> value;
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+  [[nodiscard]] pf::Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+  void result() const { rethrowIfFailed(); }
+};
+
+/**
+ * Coroutine wrapping an awaitable, calls a callback once the awaitable finishes. Used to start several tasks at once in combinators.
+ */
+class NotifyingCoroutine {
+ public:
+  using Callback = std::coroutine_handle<> (*)(void *context, std::size_t index) noexcept;
+
+  struct promise_type {
+    struct FinalAwaiter {
+      [[nodiscard]] bool await_ready() const noexcept { return false; }
+      [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+        auto &promise = handle.promise();
+        return promise.callback(promise.context, promise.index);
+      }
+      void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] NotifyingCoroutine get_return_object() noexcept {
+      return NotifyingCoroutine{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+    [[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    // exceptions stay in the awaited task
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    Callback callback = nullptr;
+    void *context = nullptr;
+    std::size_t index = 0;
+  };
+
+  NotifyingCoroutine(NotifyingCoroutine &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+  NotifyingCoroutine &operator=(NotifyingCoroutine &&other) noexcept {
+    std::swap(handle, other.handle);
+    return *this;
+  }
+  ~NotifyingCoroutine() {
+    if (handle) { handle.destroy(); }
+  }
+
+  void start(Callback callback, void *context, std::size_t index = 0) {
+    auto &promise = handle.promise();
+    promise.callback = callback;
+    promise.context = context;
+    promise.index = index;
+    handle.resume();
+  }
+
+ private:
+  explicit NotifyingCoroutine(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+template<typename T>
+[[nodiscard]] NotifyingCoroutine awaitReady(pf::Task<T> &task) {
+  co_await task.whenReady();
+}
+
+/**
+ * Counter of unfinished tasks, the awaiting coroutine is resumed by the task which finishes last.
+ * Starts at count + 1 so that tasks finishing while they are still being started can't resume the awaiting coroutine early.
+ */
+struct WhenAllCounter {
+  explicit WhenAllCounter(std::size_t count) : count(count + 1) {}
+
+  /**
+   * @return true if the awaiting coroutine should stay suspended
+   */
+  [[nodiscard]] bool trySuspend(std::coroutine_handle<> handle) noexcept {
+    continuation = handle;
+    return count.fetch_sub(1, std::memory_order_acq_rel) > 1;
+  }
+
+  static std::coroutine_handle<> onFinish(void *context, std::size_t) noexcept {
+    auto self = static_cast<WhenAllCounter *>(context);
+    if (self->count.fetch_sub(1, std::memory_order_acq_rel) == 1) { return self->continuation; }
+    return std::noop_coroutine();
+  }
+
+  std::atomic<std::size_t> count;
+  std::coroutine_handle<> continuation;
+};
+
+template<typename Coroutines>
+struct WhenAllAwaiter {
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+  [[nodiscard]] bool await_suspend(std::coroutine_handle<> handle) {
+    for (auto &coroutine : coroutines) { coroutine.start(&WhenAllCounter::onFinish, &counter); }
+    return counter.trySuspend(handle);
+  }
+  void await_resume() const noexcept {}
+
+  Coroutines &coroutines;
+  WhenAllCounter &counter;
+};
+
+template<typename T>
+using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template<typename T>
+NonVoid<T> takeResult(pf::Task<T> &task) {
+  if constexpr (std::is_void_v<T>) {
+    std::move(task.handle.promise()).result();
+    return {};
+  } else {
+    return std::move(task.handle.promise()).result();
+  }
+}
+}// namespace details
+
+/**
+ * @brief Lazily started coroutine returning T.
+ *
+ * The coroutine starts when the task is awaited and the awaiting coroutine is resumed via symmetric transfer once the task finishes,
+ * so long chains of tasks don't grow the stack. Use co_await pool.schedule() inside of the coroutine to continue on a ThreadPool.
+ * @tparam T result type
+ */
+template<typename T = void>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = details::TaskPromise<T>;
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+  Task &operator=(Task &&other) noexcept {
+    std::swap(handle, other.handle);
+    return *this;
+  }
+  ~Task() {
+    if (handle) { handle.destroy(); }
+  }
+
+  /**
+   * Start the task and wait for its result, exceptions thrown by the task are rethrown.
+   */
+  auto operator co_await() & noexcept { return Awaiter<false>{handle}; }
+  auto operator co_await() && noexcept { return Awaiter<true>{handle}; }
+
+  /**
+   * Start the task and wait for it to finish without retrieving the result.
+   */
+  [[nodiscard]] auto whenReady() noexcept {
+    struct ReadyAwaiter : Awaiter<false> {
+      void await_resume() const noexcept {}
+    };
+    return ReadyAwaiter{{handle}};
+  }
+
+  [[nodiscard]] bool isReady() const noexcept { return !handle || handle.done(); }
+
+ private:
+  friend promise_type;
+  template<typename U>
+  friend details::NonVoid<U> details::takeResult(Task<U> &);
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+  template<bool IsRvalue>
+  struct Awaiter {
+    [[nodiscard]] bool await_ready() const noexcept { return handle.done(); }
+    [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+      handle.promise().continuation = awaiting;
+      return handle;
+    }
+    decltype(auto) await_resume() {
+      if constexpr (IsRvalue) {
+        return std::move(handle.promise()).result();
+      } else {
+        return handle.promise().result();
+      }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+namespace details {
+template<typename T>
+pf::Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return pf::Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+inline pf::Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return pf::Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+}// namespace details
+
+/**
+ * Start all tasks and wait for all of them to finish.
+ * @return results in the same order as tasks, void results are replaced by std::monostate
+ * @throws first exception (in order of tasks) thrown by any of the tasks
+ */
+template<typename... Ts>
+Task<std::tuple<details::NonVoid<Ts>...>> whenAll(Task<Ts>... tasks) {
+  auto coroutines = std::array<details::NotifyingCoroutine, sizeof...(Ts)>{details::awaitReady(tasks)...};
+  auto counter = details::WhenAllCounter{sizeof...(Ts)};
+  co_await details::WhenAllAwaiter<decltype(coroutines)>{coroutines, counter};
+  co_return std::tuple<details::NonVoid<Ts>...>{details::takeResult(tasks)...};
+}
+
+/**
+ * Start all tasks and wait for all of them to finish.
+ * @return results in the same order as tasks
+ * @throws first exception (in order of tasks) thrown by any of the tasks
+ */
+template<typename T>
+auto whenAll(std::vector<Task<T>> tasks) -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<details::NonVoid<T>>>> {
+  auto coroutines = std::vector<details::NotifyingCoroutine>{};
+  coroutines.reserve(tasks.size());
+  for (auto &task : tasks) { coroutines.emplace_back(details::awaitReady(task)); }
+  auto counter = details::WhenAllCounter{tasks.size()};
+  co_await details::WhenAllAwaiter<decltype(coroutines)>{coroutines, counter};
+  if constexpr (std::is_void_v<T>) {
+    for (auto &task : tasks) { details::takeResult(task); }
+  } else {
+    auto results = std::vector<T>{};
+    results.reserve(tasks.size());
+    for (auto &task : tasks) { results.emplace_back(details::takeResult(task)); }
+    co_return results;
+  }
+}
+
+/**
+ * Result of whenAny.
+ */
+template<typename T>
+struct WhenAnyResult {
+  std::size_t index; /**< index of the first finished task */
+  T value;           /**< its result */
+};
+template<>
+struct WhenAnyResult<void> {
+  std::size_t index; /**< index of the first finished task */
+};
+
+namespace details {
+/**
+ * Shared by whenAny and all of its started tasks, deleted by whoever finishes last - the other tasks keep running after whenAny
+ * returns.
+ */
+template<typename T>
+struct WhenAnyState {
+  explicit WhenAnyState(std::vector<pf::Task<T>> &&tasks) : tasks(std::move(tasks)), references(this->tasks.size() + 1) {
+    coroutines.reserve(this->tasks.size());
+    for (auto &task : this->tasks) { coroutines.emplace_back(awaitReady(task)); }
+  }
+
+  void release() noexcept {
+    if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) { delete this; }
+  }
+
+  static std::coroutine_handle<> onFinish(void *context, std::size_t index) noexcept {
+    auto self = static_cast<WhenAnyState *>(context);
+    std::coroutine_handle<> next = std::noop_coroutine();
+    if (!self->hasWinner.exchange(true, std::memory_order_acq_rel)) {
+      self->winner = index;
+      if (self->resumeCounter.fetch_sub(1, std::memory_order_acq_rel) == 1) { next = self->continuation; }
+    }
+    // may destroy this coroutine's frame, which is fine since it's suspended
+    self->release();
+    return next;
+  }
+
+  std::vector<pf::Task<T>> tasks;
+  std::vector<NotifyingCoroutine> coroutines;
+  std::atomic<std::size_t> references;
+  std::atomic<bool> hasWinner = false;
+  std::size_t winner = 0;
+  // winner and the awaiting coroutine after starting all tasks
+  std::atomic<std::size_t> resumeCounter = 2;
+  std::coroutine_handle<> continuation;
+};
+
+template<typename T>
+struct WhenAnyAwaiter {
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+  [[nodiscard]] bool await_suspend(std::coroutine_handle<> handle) {
+    state.continuation = handle;
+    for (std::size_t i = 0; i < state.coroutines.size(); ++i) { state.coroutines[i].start(&WhenAnyState<T>::onFinish, &state, i); }
+    return state.resumeCounter.fetch_sub(1, std::memory_order_acq_rel) > 1;
+  }
+  void await_resume() const noexcept {}
+
+  WhenAnyState<T> &state;
+};
+}// namespace details
+
+/**
+ * Start all tasks and wait for the first one to finish. The other tasks keep running in the background and their results are
+ * discarded, so they must not reference anything which may be destroyed before they finish.
+ * @param tasks non empty vector of tasks
+ * @return index and result of the first finished task
+ * @throws exception thrown by the first finished task
+ */
+template<typename T>
+Task<WhenAnyResult<T>> whenAny(std::vector<Task<T>> tasks) {
+  assert(!tasks.empty() && "whenAny needs at least one task");
+  auto state = new details::WhenAnyState<T>{std::move(tasks)};
+  co_await details::WhenAnyAwaiter<T>{*state};
+  const auto index = state->winner;
+  // results of the other tasks aren't touched, so the winner can be read while they are still running
+  try {
+    if constexpr (std::is_void_v<T>) {
+      details::takeResult(state->tasks[index]);
+      state->release();
+      co_return WhenAnyResult<void>{index};
+    } else {
+      auto result = WhenAnyResult<T>{index, details::takeResult(state->tasks[index])};
+      state->release();
+      co_return result;
+    }
+  } catch (...) {
+    state->release();
+    throw;
+  }
+}
+
+/**
+ * Start the task and block the calling thread until it finishes.
+ * @return task's result
+ * @throws exception thrown by the task
+ */
+template<typename T>
+T syncWait(Task<T> task) {
+  auto finished = std::latch{1};
+  auto coroutine = details::awaitReady(task);
+  coroutine.start(
+      [](void *context, std::size_t) noexcept -> std::coroutine_handle<> {
+        static_cast<std::latch *>(context)->count_down();
+        return std::noop_coroutine();
+      },
+      &finished);
+  finished.wait();
+  if constexpr (std::is_void_v<T>) {
+    details::takeResult(task);
+  } else {
+    return details::takeResult(task);
+  }
+}
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_TASK_H
@@ -0,0 +1,204 @@
+/**
+ * @file TaskGraph.h
+ * @brief Graph of dependent tasks executed on a ThreadPool.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_TASKGRAPH_H
+#define PF_COMMON_PARALLEL_TASKGRAPH_H
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <pf_common/parallel/InplaceTask.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <utility>
+#include <vector>
+
+namespace pf {
+/**
+ * @brief Directed acyclic graph of tasks, a task is scheduled as soon as all of its dependencies finish.
+ *
+ * No worker ever blocks waiting for another task. When a task finishes, one of its ready successors is run right away on the same
+ * thread and the rest is posted to the pool. The graph can be run repeatedly, a run doesn't allocate any memory apart from the pool's
+ * queue.
+ *
+ * The graph must not be modified, run again or destroyed while it's running, that is before wait() returns or isRunning() returns
+ * false - until then the thread finishing the last task may still access the graph. If a task throws, tasks which weren't started yet are skipped and
+ * the first exception is rethrown from wait().
+ */
+class TaskGraph {
+ public:
+  using NodeId = std::size_t;
+
+  TaskGraph() = default;
+  TaskGraph(const TaskGraph &) = delete;
+  TaskGraph &operator=(const TaskGraph &) = delete;
+  TaskGraph(TaskGraph &&) = delete;
+  TaskGraph &operator=(TaskGraph &&) = delete;
+
+  /**
+   * Add a task to the graph.
+   * @param callable task, invoked once per run
+   * @return id of the new node
+   */
+  NodeId addNode(std::invocable auto &&callable) {
+    assert(!isRunning() && "TaskGraph can't be modified while running");
+    nodes.emplace_back(std::forward<decltype(callable)>(callable));
+    return nodes.size() - 1;
+  }
+
+  /**
+   * Add a dependency - task 'to' runs after task 'from' finishes.
+   */
+  void addEdge(NodeId from, NodeId to) {
+    assert(!isRunning() && "TaskGraph can't be modified while running");
+    assert(from < nodes.size() && to < nodes.size() && from != to);
+    nodes[from].successors.emplace_back(to);
+    ++nodes[to].dependencyCount;
+  }
+
+  /**
+   * Start execution of all tasks, returns immediately. Use wait() to wait for the graph to finish.
+   * @param pool pool to run the tasks on
+   */
+  template<template<typename> typename Queue>
+  void run(BasicThreadPool<Queue> &pool) {
+    assert(!isRunning() && "TaskGraph is already running");
+    assert(isAcyclic() && "TaskGraph contains a cycle");
+    failed = false;
+    exception = nullptr;
+    if (nodes.empty()) { return; }
+    scheduleFnc = [](void *poolPtr, TaskGraph *graph, NodeId id) {
+      static_cast<BasicThreadPool<Queue> *>(poolPtr)->post([graph, id] { graph->runNode(id); });
+    };
+    this->pool = &pool;
+    for (auto &node : nodes) { node.remainingDependencies.store(node.dependencyCount, std::memory_order_relaxed); }
+    {
+      std::lock_guard lock{finishMutex};
+      unfinishedNodes.store(nodes.size());
+      finished = false;
+    }
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+      if (nodes[id].dependencyCount == 0) { scheduleFnc(this->pool, this, id); }
+    }
+  }
+
+  /**
+   * Wait for the current run to finish.
+   * @throws first exception thrown by a task during the run
+   */
+  void wait() {
+    {
+      std::unique_lock lock{finishMutex};
+      finishCondition.wait(lock, [this] { return finished; });
+    }
+    if (failed.load()) { std::rethrow_exception(exception); }
+  }
+
+  /**
+   * Run the graph and wait for it to finish. Blocks the calling thread, so it shouldn't be used from inside of the pool's tasks.
+   */
+  template<template<typename> typename Queue>
+  void runAndWait(BasicThreadPool<Queue> &pool) {
+    run(pool);
+    wait();
+  }
+
+  /**
+   * @return true until the thread finishing the last task of the run is done with the graph
+   */
+  [[nodiscard]] bool isRunning() const {
+    std::lock_guard lock{finishMutex};
+    return !finished;
+  }
+  [[nodiscard]] std::size_t getNodeCount() const { return nodes.size(); }
+
+  /**
+   * @return true if there is no cycle in dependencies
+   */
+  [[nodiscard]] bool isAcyclic() const {
+    // Kahn's algorithm
+    auto inDegrees = std::vector<std::size_t>{};
+    auto ready = std::vector<NodeId>{};
+    inDegrees.reserve(nodes.size());
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+      inDegrees.emplace_back(nodes[id].dependencyCount);
+      if (nodes[id].dependencyCount == 0) { ready.emplace_back(id); }
+    }
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+      const auto id = ready.back();
+      ready.pop_back();
+      ++visited;
+      for (const auto successor : nodes[id].successors) {
+        if (--inDegrees[successor] == 0) { ready.emplace_back(successor); }
+      }
+    }
+    return visited == nodes.size();
+  }
+
+ private:
+  constexpr static NodeId NO_NODE = std::numeric_limits<NodeId>::max();
+
+  struct Node {
+    explicit Node(std::invocable auto &&callable) : task(std::forward<decltype(callable)>(callable)) {}
+
+    InplaceTask<> task;
+    std::vector<NodeId> successors;
+    std::size_t dependencyCount = 0;
+    std::atomic<std::size_t> remainingDependencies = 0;
+  };
+
+  void runNode(NodeId id) {
+    for (auto current = id; current != NO_NODE;) {
+      auto &node = nodes[current];
+      if (!failed.load(std::memory_order_relaxed)) {
+        try {
+          node.task();
+        } catch (...) {
+          std::lock_guard lock{finishMutex};
+          if (!failed.exchange(true)) { exception = std::current_exception(); }
+        }
+      }
+      auto next = NO_NODE;
+      for (const auto successor : node.successors) {
+        if (nodes[successor].remainingDependencies.fetch_sub(1) == 1) {
+          if (next == NO_NODE) {
+            next = successor;
+          } else {
+            scheduleFnc(pool, this, successor);
+          }
+        }
+      }
+      // while next is set the counter can't reach 0, after the last node nothing but the mutex is touched - the run ends once
+      // finished is set, so the graph may be run again or destroyed as soon as the lock is released
+      if (unfinishedNodes.fetch_sub(1) == 1) {
+        std::lock_guard lock{finishMutex};
+        finished = true;
+        finishCondition.notify_all();
+      }
+      current = next;
+    }
+  }
+
+  std::deque<Node> nodes;
+  void *pool = nullptr;
+  void (*scheduleFnc)(void *, TaskGraph *, NodeId) = nullptr;
+  std::atomic<std::size_t> unfinishedNodes = 0;
+  std::atomic<bool> failed = false;
+  std::exception_ptr exception;
+  mutable std::mutex finishMutex;
+  std::condition_variable finishCondition;
+  bool finished = true;
+};
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_TASKGRAPH_H
@@ -9,100 +9,1004 @@
 #define PF_COMMON_PARALLEL_THREADPOOL_H
 
 #include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
 #include <functional>
+#include <list>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pf_common/allocators/PoolAllocator.h>
+#include <pf_common/parallel/Cancellation.h>
+#include <pf_common/parallel/CpuTopology.h>
+#include <pf_common/parallel/InplaceTask.h>
 #include <pf_common/parallel/SafeQueue.h>
+#include <pf_common/parallel/ThreadPoolStats.h>
 #include <ranges>
+#include <span>
+#include <stop_token>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace pf {
 namespace details {
-struct Task {
-  void operator()() { execute(); }
-  virtual void execute() = 0;
+/**
+ * Task stored in the pool's queues. Inline storage fits a callable with up to 64 bytes of captures along with its promise.
+ */
+using Task = InplaceTask<64 + sizeof(std::promise<void>)>;
+
+/**
+ * @brief Per worker deque used in work stealing mode.
+ *
+ * Owner pushes and pops from the back (LIFO for cache locality), thieves take from the front.
+ */
+template<typename T>
+class WorkStealingDeque {
+ public:
+  void push(T &&item) {
+    std::lock_guard lock{mtx};
+    items.push_back(std::move(item));
+  }
+
+  void pushRange(std::span<T> range) {
+    std::lock_guard lock{mtx};
+    items.insert(items.end(), std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+  }
 
-  virtual ~Task() = default;
+  [[nodiscard]] std::optional<T> pop() {
+    std::lock_guard lock{mtx};
+    if (items.empty()) { return std::nullopt; }
+    auto result = std::move(items.back());
+    items.pop_back();
+    return result;
+  }
+
+  [[nodiscard]] std::optional<T> steal() {
+    std::lock_guard lock{mtx};
+    if (items.empty()) { return std::nullopt; }
+    auto result = std::move(items.front());
+    items.pop_front();
+    return result;
+  }
+
+ private:
+  std::mutex mtx;
+  std::deque<T> items;
 };
 
+/**
+ * Count of tasks a worker runs in a row from a higher priority level while a lower level has waiting tasks, then one task of the lower
+ * level is run.
+ */
+inline constexpr std::size_t PRIORITY_STARVATION_LIMIT = 16;
+
+/**
+ * @brief Queues of ThreadPool's High and Low priority tasks, Normal priority tasks use the pool's regular queues.
+ */
 template<typename T>
-struct PTask : public Task {
-  explicit PTask(std::packaged_task<T()> &&task) : task(std::move(task)) {}
-  void execute() override { task(); }
-  std::packaged_task<T()> task;
+class PrioritizedTaskQueues {
+ public:
+  void push(bool high, T &&item) {
+    std::lock_guard lock{mtx};
+    (high ? highItems : lowItems).push_back(std::move(item));
+    (high ? highCount : lowCount).fetch_add(1);
+  }
+
+  [[nodiscard]] std::optional<T> pop(bool high) {
+    if ((high ? highCount : lowCount).load() == 0) { return std::nullopt; }
+    std::lock_guard lock{mtx};
+    auto &items = high ? highItems : lowItems;
+    if (items.empty()) { return std::nullopt; }
+    auto result = std::move(items.front());
+    items.pop_front();
+    (high ? highCount : lowCount).fetch_sub(1);
+    return result;
+  }
+
+  [[nodiscard]] bool hasHigh() const { return highCount.load() != 0; }
+  [[nodiscard]] bool hasLow() const { return lowCount.load() != 0; }
+  [[nodiscard]] bool isEmpty() const { return !hasHigh() && !hasLow(); }
+
+ private:
+  std::mutex mtx;
+  std::deque<T> highItems;
+  std::deque<T> lowItems;
+  std::atomic<std::size_t> highCount = 0;
+  std::atomic<std::size_t> lowCount = 0;
+};
+
+/**
+ * Per worker state of starvation protection.
+ */
+struct PriorityStreak {
+  std::size_t high = 0;      /**< High priority tasks run in a row */
+  std::size_t waitedLow = 0; /**< other tasks run while Low priority tasks were waiting */
 };
+
+/**
+ * Pool and index of the worker running on current thread, used to route submissions from workers to their local queue.
+ */
+inline thread_local const void *currentPool = nullptr;
+inline thread_local std::size_t currentWorkerIndex = 0;
 }// namespace details
 
+/**
+ * Queue usable as a backing queue of ThreadPool, e.g. SafeQueue or MPMCQueue.
+ * A bounded queue has to provide tryEnqueue(), which leaves the item untouched on failure. Workers of the pool submitting nested tasks
+ * can't wait for space in the queue, since they might be the ones supposed to make it, so they run the task themselves when it's full.
+ */
+template<typename Q, typename T>
+concept ConcurrentQueue = std::default_initializable<Q> && requires(Q queue, T &&item) {
+  queue.enqueue(std::move(item));
+  { queue.dequeue() } -> std::same_as<std::optional<T>>;
+  queue.shutdown();
+  { queue.isEmpty() } -> std::convertible_to<bool>;
+};
+
 enum class ThreadPoolState { Run, Stop, FinishAndStop };
 
+/**
+ * Scheduling strategy of ThreadPool.
+ */
+enum class ThreadPoolMode {
+  SharedQueue,  /**< all workers pull from one shared queue */
+  WorkStealing, /**< each worker has its own deque, idle workers steal from others */
+  Elastic       /**< like SharedQueue, but workers are added under load and retired when idle, see ElasticPoolConfig */
+};
+
+/**
+ * Configuration of ThreadPool in elastic mode.
+ */
+struct ElasticPoolConfig {
+  /** Workers living for the whole lifetime of the pool. */
+  std::size_t minThreads = 1;
+  /** Upper limit of worker count. */
+  std::size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  /** Count of queued tasks per new worker when no worker is idle, checked on submission and when a worker takes a task. */
+  std::size_t growQueueDepth = 1;
+  /**
+   * A worker is added when tasks are queued and no task was taken from the queue for this long. Also checked by a monitor thread
+   * while all workers are busy, so the pool grows even when nothing is submitted.
+   */
+  std::chrono::microseconds maxWaitTime{1000};
+  /** Workers above minThreads exit after being idle for this long. */
+  std::chrono::milliseconds idleTimeout{5000};
+};
+
+/**
+ * Placement of ThreadPool's workers on cpus.
+ */
+struct WorkerPlacement {
+  /** Pin each worker to a single cpu. */
+  bool pinToCores = false;
+  /**
+   * Split workers evenly between NUMA nodes and restrict them to cpus of their node. In work stealing mode each node also gets
+   * a queue for node local submissions and workers steal from their own node first.
+   */
+  bool groupByNumaNode = false;
+};
+
+/**
+ * Priority of a task submitted to ThreadPool.
+ */
+enum class TaskPriority {
+  High,   /**< run before other tasks as soon as a worker finishes its current task */
+  Normal, /**< default, same as submission without priority */
+  Low     /**< run when there are no other tasks */
+};
+
 /**
 * @brief A thread pool running queued tasks in threads.
+*
+* Tasks can be submitted with a TaskPriority. High priority tasks are picked before anything else, Low priority tasks only when no
+* other task is queued. To prevent starvation a worker runs one lower priority task after PRIORITY_STARVATION_LIMIT higher priority
+* ones.
+* @tparam Queue queue used in SharedQueue and Elastic modes
 */
-class ThreadPool {
+template<template<typename> typename Queue = SafeQueue>
+  requires ConcurrentQueue<Queue<details::Task>, details::Task>
+class BasicThreadPool {
  public:
   /**
   * Construct ThreadPool.
-  * @param threadCount count of threads handling tasks
+  * @param threadCount count of threads handling tasks, work stealing mode always has at least one as tasks are queued to workers
+  * @param mode scheduling strategy
+  * @param placement placement of workers on cpus
+  */
+  inline explicit BasicThreadPool(std::size_t threadCount, ThreadPoolMode mode = ThreadPoolMode::SharedQueue,
+                                  const WorkerPlacement &placement = {})
+      : mode(mode) {
+    assert(mode != ThreadPoolMode::Elastic && "Use ElasticPoolConfig constructor for elastic mode");
+    if (mode == ThreadPoolMode::WorkStealing) {
+      threadCount = std::max<std::size_t>(threadCount, 1);
+      localQueues.resize(threadCount);
+    }
+    if (placement.groupByNumaNode || placement.pinToCores) { assignNodes(threadCount, placement); }
+    threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+      threads.emplace_back([this, i] {
+        details::currentPool = this;
+        details::currentWorkerIndex = i;
+        // pinned before touching any memory, so its stack and local queue are placed on the worker's node
+        if (!workerCpus.empty()) { pinCurrentThread(workerCpus[i]); }
+        if (this->mode == ThreadPoolMode::WorkStealing) {
+          localQueues[i] = std::make_unique<details::WorkStealingDeque<details::Task>>();
+          createdLocalQueues.fetch_add(1);
+          createdLocalQueues.notify_all();
+          waitForLocalQueues();
+          workStealingThreadLoop(i);
+        } else {
+          threadLoop();
+        }
+      });
+    }
+    if (mode == ThreadPoolMode::WorkStealing) { waitForLocalQueues(); }
+  }
+  /**
+  * Construct ThreadPool in elastic mode.
+  * The pool starts with config.minThreads workers. When no worker is idle and either there are at least growQueueDepth tasks waiting
+  * per new worker or no task was taken from the queue for maxWaitTime, more workers are started up to maxThreads. This is checked
+  * when a task is submitted and when a worker takes a task from the queue. While tasks are queued and all workers are busy, a monitor
+  * thread checks it every maxWaitTime as well. Workers above minThreads exit after idleTimeout without a task.
+  * @param config elastic mode configuration
   */
-  inline explicit ThreadPool(std::size_t threadCount) {
-    threads.resize(threadCount);
-    std::ranges::generate(threads.begin(), threads.end(), [this] { return std::thread{[this] { threadLoop(); }}; });
+  inline explicit BasicThreadPool(const ElasticPoolConfig &config)
+    requires requires(Queue<details::Task> q) { q.dequeueFor(std::chrono::milliseconds{}); }
+      : mode(ThreadPoolMode::Elastic), elasticConfig(config) {
+    assert(config.minThreads <= config.maxThreads && config.maxThreads > 0 && config.growQueueDepth > 0);
+    lastQueueProgress.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    threads.reserve(config.minThreads);
+    for (std::size_t i = 0; i < config.minThreads; ++i) {
+      threads.emplace_back([this, i] {
+        details::currentPool = this;
+        details::currentWorkerIndex = i;
+        threadLoop();
+      });
+    }
+    for (auto slot = config.maxThreads; slot > config.minThreads; --slot) { freeElasticSlots.emplace_back(slot - 1); }
+    elasticMonitor = std::thread{[this] { elasticMonitorLoop(); }};
   }
-  ThreadPool(const ThreadPool &) = delete;
-  ThreadPool &operator=(const ThreadPool &) = delete;
-  ThreadPool(ThreadPool &&) = default;
-  ThreadPool &operator=(ThreadPool &&) = default;
+  BasicThreadPool(const BasicThreadPool &) = delete;
+  BasicThreadPool &operator=(const BasicThreadPool &) = delete;
+  BasicThreadPool(BasicThreadPool &&) = delete;
+  BasicThreadPool &operator=(BasicThreadPool &&) = delete;
 
   /**
   * Enqueue a task to be executed when possible.
+  * When called from a worker of this pool in work stealing mode the task is placed to the worker's local queue.
+  * Callables with up to 64 bytes of captures are stored inline and the promise's shared state comes from PoolAllocator, so in
+  * steady state no global allocation happens.
+  * @param callable task to be run, callables also accepting std::stop_token are submitted as cancellable tasks
+  * @return future, resolved when task is finished
+  */
+  auto enqueue(std::invocable auto &&callable)
+    requires(!std::invocable<decltype(callable), std::stop_token>)
+  {
+    auto [task, future] = makeTask(std::forward<decltype(callable)>(callable));
+    push(instrument(std::move(task)));
+    return std::move(future);
+  }
+
+  /**
+  * Enqueue a cancellable task. It receives a std::stop_token which is triggered by the returned future's requestStop() or by
+  * cancelAndStop() of the pool. A task cancelled before it started is not run and its future holds TaskCancelled.
+  * @param callable task to be run, invoked with std::stop_token
+  * @return future with the ability to request stop of the task
+  */
+  template<std::invocable<std::stop_token> F>
+  auto enqueue(F &&callable) {
+    return enqueue(std::stop_token{}, std::forward<F>(callable));
+  }
+  /**
+  * Enqueue a cancellable task belonging to a group. Stop of the whole group is requested through the std::stop_source the group
+  * token comes from, the task can also be cancelled separately through the returned future.
+  * @param groupToken token of the group
+  * @param callable task to be run, invoked with std::stop_token
+  * @return future with the ability to request stop of the task
+  */
+  template<std::invocable<std::stop_token> F>
+  auto enqueue(std::stop_token groupToken, F &&callable) {
+    using result_type = std::invoke_result_t<F, std::stop_token>;
+    auto stopSource = std::stop_source{};
+    auto [task, future] = makeTask(makeCancellable(std::move(groupToken), stopSource, std::forward<F>(callable)));
+    push(instrument(std::move(task)));
+    return CancellableFuture<result_type>{std::move(future), std::move(stopSource)};
+  }
+
+  /**
+  * Enqueue a task with given priority.
+  * @param priority priority of the task
   * @param callable task to be run
   * @return future, resolved when task is finished
   */
-  auto enqueue(std::invocable auto &&callable) {
-    using result_type = std::invoke_result_t<decltype(callable)>;
-    auto task = std::packaged_task<result_type()>(std::forward<decltype(callable)>(callable));
-    auto future = task.get_future();
-    queue.enqueue(std::make_unique<details::PTask<result_type>>(std::move(task)));
-    return future;
+  auto enqueue(TaskPriority priority, std::invocable auto &&callable) {
+    auto [task, future] = makeTask(std::forward<decltype(callable)>(callable));
+    push(priority, instrument(std::move(task)));
+    return std::move(future);
+  }
+
+  /**
+  * Enqueue a task to a NUMA node, it is run by one of the node's workers unless they are all busy and others are idle.
+  * Only work stealing mode has node queues, the pool must be in that mode. Without WorkerPlacement::groupByNumaNode there are no
+  * nodes to target and this is the same as enqueue(callable).
+  * @param node index of the node in getNumaNodes()
+  * @param callable task to be run
+  * @return future, resolved when task is finished
+  */
+  auto enqueueOnNode(std::size_t node, std::invocable auto &&callable) {
+    auto [task, future] = makeTask(std::forward<decltype(callable)>(callable));
+    pushToNode(node, instrument(std::move(task)));
+    return std::move(future);
+  }
+
+  /**
+  * Enqueue a task without creating a future for its result.
+  * The callable must not throw - an exception escaping it terminates the program.
+  * @param callable task to be run
+  */
+  void post(std::invocable auto &&callable) { push(instrument(details::Task{std::forward<decltype(callable)>(callable)})); }
+  /**
+  * Enqueue a task belonging to a cancellation group without creating a future for its result, see enqueue(groupToken, callable).
+  * The callable must not throw - an exception escaping it terminates the program.
+  * @param groupToken token of the group
+  * @param callable task to be run, invoked with std::stop_token
+  */
+  template<std::invocable<std::stop_token> F>
+  void post(std::stop_token groupToken, F &&callable) {
+    auto cancellable = makeCancellable(std::move(groupToken), std::stop_source{}, std::forward<F>(callable));
+    push(instrument(details::Task{[cancellable = std::move(cancellable)]() mutable {
+      try {
+        cancellable();
+      } catch (const TaskCancelled &) {}
+    }}));
+  }
+  /**
+  * Enqueue a task with given priority without creating a future for its result.
+  * The callable must not throw - an exception escaping it terminates the program.
+  * @param priority priority of the task
+  * @param callable task to be run
+  */
+  void post(TaskPriority priority, std::invocable auto &&callable) {
+    push(priority, instrument(details::Task{std::forward<decltype(callable)>(callable)}));
+  }
+
+  /**
+  * Enqueue a task to a NUMA node without creating a future for its result, see enqueueOnNode.
+  * The callable must not throw - an exception escaping it terminates the program.
+  * @param node index of the node in getNumaNodes()
+  * @param callable task to be run
+  */
+  void postOnNode(std::size_t node, std::invocable auto &&callable) {
+    pushToNode(node, instrument(details::Task{std::forward<decltype(callable)>(callable)}));
+  }
+
+  /**
+  * Enqueue all callables in the range with a single queue operation and wake up as many workers as needed.
+  * Elements of an rvalue container are moved from, otherwise they are copied.
+  * @param callables range of callables
+  * @return futures in the same order as callables
+  */
+  template<std::ranges::input_range R>
+    requires std::invocable<std::ranges::range_value_t<R>>
+  auto enqueueBulk(R &&callables) {
+    using result_type = std::invoke_result_t<std::ranges::range_value_t<R>>;
+    auto tasks = std::vector<details::Task>{};
+    auto futures = std::vector<std::future<result_type>>{};
+    if constexpr (std::ranges::sized_range<R>) {
+      tasks.reserve(std::ranges::size(callables));
+      futures.reserve(std::ranges::size(callables));
+    }
+    for (auto &&callable : callables) {
+      auto [task, future] = makeTask(forwardElement<R>(callable));
+      tasks.emplace_back(instrument(std::move(task)));
+      futures.emplace_back(std::move(future));
+    }
+    pushBulk(std::move(tasks));
+    return futures;
+  }
+
+  /**
+  * Enqueue all callables in the range with a single queue operation, no futures are created.
+  * Elements of an rvalue container are moved from, otherwise they are copied.
+  * The callables must not throw - an exception escaping them terminates the program.
+  * @param callables range of callables
+  */
+  template<std::ranges::input_range R>
+    requires std::invocable<std::ranges::range_value_t<R>>
+  void postBulk(R &&callables) {
+    auto tasks = std::vector<details::Task>{};
+    if constexpr (std::ranges::sized_range<R>) { tasks.reserve(std::ranges::size(callables)); }
+    for (auto &&callable : callables) { tasks.emplace_back(instrument(details::Task{forwardElement<R>(callable)})); }
+    pushBulk(std::move(tasks));
+  }
+
+  /**
+  * Awaitable resuming the awaiting coroutine on one of the pool's workers: co_await pool.schedule();
+  */
+  [[nodiscard]] auto schedule() noexcept {
+    struct ScheduleAwaiter {
+      [[nodiscard]] bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) { pool.post([handle] { handle.resume(); }); }
+      void await_resume() const noexcept {}
+
+      BasicThreadPool &pool;
+    };
+    return ScheduleAwaiter{*this};
   }
 
   /**
   * Finish remaining tasks and stop.
   */
-  inline void finishAndStop() { state = ThreadPoolState::FinishAndStop; }
+  inline void finishAndStop() {
+    auto expected = ThreadPoolState::Run;
+    if (!state.compare_exchange_strong(expected, ThreadPoolState::FinishAndStop)) { return; }
+    if (unfinishedTasks.load() == 0) { stopWorkers(); }
+  }
   /**
   * Clear remaining tasks and stop.
   */
   inline void cancelAndStop() {
+    cancelSource.request_stop();
     state = ThreadPoolState::Stop;
-    queue.shutdown();
+    stopWorkers();
   }
 
-  inline ~ThreadPool() {
-    if (state == ThreadPoolState::Run) { state = ThreadPoolState::FinishAndStop; }
-    queue.shutdown();
-    if (state == ThreadPoolState::FinishAndStop) {
-      while (!queue.isEmpty()) {};
+  [[nodiscard]] inline ThreadPoolMode getMode() const { return mode; }
+  /**
+  * @return current count of workers, in elastic mode it changes over time
+  */
+  [[nodiscard]] inline std::size_t getThreadCount() const { return threads.size() + elasticThreadCount.load(); }
+  [[nodiscard]] inline const ElasticPoolConfig &getElasticConfig() const { return elasticConfig; }
+
+  /**
+  * Start collecting statistics, see getStats(). Only tasks submitted afterwards are measured. Until this is called, the only cost
+  * of statistics is a check of a pointer on task submission.
+  */
+  inline void enableStats() {
+    std::lock_guard lock{statsMutex};
+    if (statsCollector != nullptr) { return; }
+    statsCollector = std::make_unique<details::ThreadPoolStatsCollector>(getWorkerSlotCount());
+    stats.store(statsCollector.get(), std::memory_order_release);
+  }
+  /**
+  * @return snapshot of statistics, std::nullopt if they are not enabled
+  */
+  [[nodiscard]] inline std::optional<ThreadPoolStats> getStats() const {
+    const auto collector = stats.load(std::memory_order_acquire);
+    if (collector == nullptr) { return std::nullopt; }
+    return collector->snapshot(getWorkerSlotCount());
+  }
+  /**
+  * @return NUMA nodes the workers are placed on, empty if WorkerPlacement wasn't used
+  */
+  [[nodiscard]] inline std::span<const NumaNode> getNumaNodes() const { return numaNodes; }
+  /**
+  * @return index of worker's node in getNumaNodes()
+  */
+  [[nodiscard]] inline std::size_t getWorkerNode(std::size_t workerIndex) const {
+    return workerNodes.empty() ? 0 : workerNodes[workerIndex];
+  }
+
+  inline ~BasicThreadPool() {
+    if (elasticMonitor.joinable()) {
+      {
+        std::lock_guard lock{monitorMutex};
+        stopMonitor = true;
+      }
+      monitorCondition.notify_one();
+      elasticMonitor.join();
     }
+    finishAndStop();
     for (auto &thread : threads) { thread.join(); }
+    if (mode == ThreadPoolMode::Elastic) {
+      auto remainingThreads = std::list<std::thread>{};
+      {
+        std::lock_guard lock{elasticMutex};
+        joiningElasticThreads = true;
+        remainingThreads.splice(remainingThreads.end(), elasticThreads);
+        remainingThreads.splice(remainingThreads.end(), retiredThreads);
+      }
+      for (auto &thread : remainingThreads) { thread.join(); }
+    }
   }
 
  private:
+
+  ThreadPoolMode mode;
   std::vector<std::thread> threads;
-  SafeQueue<std::unique_ptr<details::Task>> queue;
-  ThreadPoolState state = ThreadPoolState::Run;
+  Queue<details::Task> queue;
+  std::atomic<ThreadPoolState> state = ThreadPoolState::Run;
+  std::stop_source cancelSource;
+  std::atomic<std::size_t> unfinishedTasks = 0;
+  details::PrioritizedTaskQueues<details::Task> prioritizedTasks;
+
+  // elastic mode
+  ElasticPoolConfig elasticConfig;
+  std::atomic<std::size_t> elasticThreadCount = 0;
+  std::atomic<std::size_t> idleWorkers = 0;
+  std::atomic<std::chrono::steady_clock::rep> lastQueueProgress = 0;
+  std::mutex elasticMutex;
+  std::list<std::thread> elasticThreads;
+  std::list<std::thread> retiredThreads;
+  bool joiningElasticThreads = false;
+  std::vector<std::size_t> freeElasticSlots;
+  std::thread elasticMonitor;
+  std::mutex monitorMutex;
+  std::condition_variable monitorCondition;
+  std::atomic<bool> monitorParked = false;
+  bool stopMonitor = false;
 
-  inline void threadLoop() {
+  // statistics
+  std::mutex statsMutex;
+  std::unique_ptr<details::ThreadPoolStatsCollector> statsCollector;
+  std::atomic<details::ThreadPoolStatsCollector *> stats = nullptr;
+
+  // worker placement
+  std::vector<NumaNode> numaNodes;
+  std::vector<std::size_t> workerNodes;
+  std::vector<std::vector<std::size_t>> workerCpus;
+
+  // work stealing mode
+  std::vector<std::unique_ptr<details::WorkStealingDeque<details::Task>>> localQueues;
+  std::vector<std::unique_ptr<details::WorkStealingDeque<details::Task>>> nodeQueues;
+  std::vector<std::vector<std::size_t>> stealOrders;
+  std::atomic<std::size_t> pendingTasks = 0;
+  std::atomic<std::size_t> sleepingWorkers = 0;
+  std::atomic<std::size_t> nextQueueIndex = 0;
+  std::atomic<std::size_t> createdLocalQueues = 0;
+  std::mutex sleepMutex;
+  std::condition_variable sleepCondition;
+
+  inline void push(details::Task &&task) {
+    unfinishedTasks.fetch_add(1);
+    if (mode != ThreadPoolMode::WorkStealing) {
+      pushToQueue(std::move(task));
+      if (mode == ThreadPoolMode::Elastic) { growIfNeeded(); }
+      return;
+    }
+    const auto index = details::currentPool == this ? details::currentWorkerIndex : nextQueueIndex++ % localQueues.size();
+    pendingTasks.fetch_add(1);
+    localQueues[index]->push(std::move(task));
+    wakeWorkers(1);
+  }
+
+  inline void push(TaskPriority priority, details::Task &&task) {
+    if (priority == TaskPriority::Normal) {
+      push(std::move(task));
+      return;
+    }
+    unfinishedTasks.fetch_add(1);
+    prioritizedTasks.push(priority == TaskPriority::High, std::move(task));
+    if (mode != ThreadPoolMode::WorkStealing) {
+      // busy workers check prioritized tasks before taking the next one from the queue, only sleeping ones have to be woken up
+      if (queue.isEmpty()) { push(details::Task{[this] { runPrioritized(); }}); }
+      return;
+    }
+    pendingTasks.fetch_add(1);
+    wakeWorkers(1);
+  }
+
+  /**
+  * Take a High or Low priority task if it should run before regular tasks.
+  * @param streak starvation protection state of the calling worker
+  * @param regularEmpty true if there are no regular tasks, Low priority tasks are only taken in that case or when starving
+  */
+  [[nodiscard]] inline std::optional<details::Task> popPrioritized(details::PriorityStreak &streak, bool regularEmpty) {
+    if (streak.high < details::PRIORITY_STARVATION_LIMIT) {
+      if (auto task = prioritizedTasks.pop(true); task.has_value()) {
+        ++streak.high;
+        if (prioritizedTasks.hasLow()) { ++streak.waitedLow; }
+        return task;
+      }
+    }
+    streak.high = 0;
+    if (regularEmpty || streak.waitedLow >= details::PRIORITY_STARVATION_LIMIT) {
+      if (auto task = prioritizedTasks.pop(false); task.has_value()) {
+        streak.waitedLow = 0;
+        return task;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /**
+  * Body of a task used to wake up a worker sleeping on the shared queue when a prioritized task arrives.
+  */
+  inline void runPrioritized() {
+    auto streak = details::PriorityStreak{};
+    if (auto task = popPrioritized(streak, queue.isEmpty()); task.has_value()) { runTask(*task); }
+  }
+
+  [[nodiscard]] inline std::size_t getWorkerSlotCount() const {
+    return mode == ThreadPoolMode::Elastic ? elasticConfig.maxThreads : threads.size();
+  }
+
+  /**
+  * Wrap task so that it records its wait and execution time, if statistics are enabled.
+  */
+  [[nodiscard]] inline details::Task instrument(details::Task &&task) {
+    using clock = details::ThreadPoolStatsCollector::clock;
+    const auto collector = stats.load(std::memory_order_acquire);
+    if (collector == nullptr) { return std::move(task); }
+    collector->onSubmit(1);
+    return details::Task{[collector, submitTime = clock::now(), task = std::move(task)]() mutable {
+      const auto startTime = clock::now();
+      const auto workerSlot = details::currentWorkerIndex;
+      collector->onStart(workerSlot, startTime - submitTime);
+      task();
+      collector->onFinish(workerSlot, clock::now() - startTime);
+    }};
+  }
+
+  /**
+  * Assign workers to NUMA nodes and cpus, prepare node queues and steal orders preferring the own node.
+  */
+  inline void assignNodes(std::size_t threadCount, const WorkerPlacement &placement) {
+    numaNodes = readNumaTopology();
+    if (!placement.groupByNumaNode) {
+      // workers are only pinned, all cpus are treated as a single node
+      auto allCpus = NumaNode{0, {}};
+      for (const auto &node : numaNodes) { allCpus.cpus.insert(allCpus.cpus.end(), node.cpus.begin(), node.cpus.end()); }
+      numaNodes = {std::move(allCpus)};
+    }
+    workerNodes.resize(threadCount);
+    workerCpus.resize(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+      // contiguous blocks of workers per node
+      const auto node = i * numaNodes.size() / threadCount;
+      const auto firstInNode = (node * threadCount + numaNodes.size() - 1) / numaNodes.size();
+      const auto &cpus = numaNodes[node].cpus;
+      workerNodes[i] = node;
+      if (placement.pinToCores) {
+        workerCpus[i] = {cpus[(i - firstInNode) % cpus.size()]};
+      } else {
+        workerCpus[i] = cpus;
+      }
+    }
+    if (mode != ThreadPoolMode::WorkStealing || !placement.groupByNumaNode) { return; }
+    nodeQueues.resize(numaNodes.size());
+    std::ranges::generate(nodeQueues, [] { return std::make_unique<details::WorkStealingDeque<details::Task>>(); });
+    stealOrders.resize(threadCount);
+    for (std::size_t worker = 0; worker < threadCount; ++worker) {
+      auto remote = std::vector<std::size_t>{};
+      for (std::size_t i = 1; i < threadCount; ++i) {
+        const auto victim = (worker + i) % threadCount;
+        (workerNodes[victim] == workerNodes[worker] ? stealOrders[worker] : remote).emplace_back(victim);
+      }
+      stealOrders[worker].insert(stealOrders[worker].end(), remote.begin(), remote.end());
+    }
+  }
+
+  /**
+  * Wait until all workers created their local queues, so that they can be stolen from.
+  */
+  inline void waitForLocalQueues() {
+    for (auto created = createdLocalQueues.load(); created != localQueues.size(); created = createdLocalQueues.load()) {
+      createdLocalQueues.wait(created);
+    }
+  }
+
+  inline void pushToNode(std::size_t node, details::Task &&task) {
+    assert(mode == ThreadPoolMode::WorkStealing && "Tasks can only be submitted to a node in work stealing mode");
+    if (nodeQueues.empty() || (details::currentPool == this && workerNodes[details::currentWorkerIndex] == node)) {
+      push(std::move(task));
+      return;
+    }
+    assert(node < nodeQueues.size());
+    unfinishedTasks.fetch_add(1);
+    pendingTasks.fetch_add(1);
+    nodeQueues[node]->push(std::move(task));
+    wakeWorkers(1);
+  }
+
+  template<typename R>
+  static decltype(auto) forwardElement(auto &element) {
+    if constexpr (std::is_rvalue_reference_v<R &&> && !std::ranges::view<std::remove_cvref_t<R>>) {
+      return std::move(element);
+    } else {
+      return element;
+    }
+  }
+
+  /**
+  * Wrap a callable accepting std::stop_token, the token is triggered by stopSource, groupToken or cancelAndStop().
+  * @return callable throwing TaskCancelled if stop was requested before it started
+  */
+  template<typename F>
+  auto makeCancellable(std::stop_token groupToken, std::stop_source stopSource, F &&callable) {
+    return [groupToken = std::move(groupToken), stopSource = std::move(stopSource), poolToken = cancelSource.get_token(),
+            callable = std::forward<F>(callable)]() mutable {
+      const auto requestStop = [&stopSource] { stopSource.request_stop(); };
+      const auto groupLink = std::stop_callback{groupToken, requestStop};
+      const auto poolLink = std::stop_callback{poolToken, requestStop};
+      if (stopSource.stop_requested()) { throw TaskCancelled{}; }
+      return std::invoke(callable, stopSource.get_token());
+    };
+  }
+
+  static auto makeTask(std::invocable auto &&callable) {
+    using result_type = std::invoke_result_t<decltype(callable)>;
+    auto promise = std::promise<result_type>{std::allocator_arg, PoolAllocator<std::byte>{}};
+    auto future = promise.get_future();
+    auto task = details::Task{[promise = std::move(promise), callable = std::forward<decltype(callable)>(callable)]() mutable {
+      try {
+        if constexpr (std::same_as<result_type, void>) {
+          std::invoke(callable);
+          promise.set_value();
+        } else {
+          promise.set_value(std::invoke(callable));
+        }
+      } catch (...) { promise.set_exception(std::current_exception()); }
+    }};
+    return std::pair{std::move(task), std::move(future)};
+  }
+
+  inline void pushBulk(std::vector<details::Task> &&tasks) {
+    if (tasks.empty()) { return; }
+    unfinishedTasks.fetch_add(tasks.size());
+    if (mode != ThreadPoolMode::WorkStealing) {
+      if constexpr (requires { queue.enqueueRange(tasks); }) {
+        queue.enqueueRange(tasks);
+      } else {
+        for (auto &task : tasks) { pushToQueue(std::move(task)); }
+      }
+      if (mode == ThreadPoolMode::Elastic) { growIfNeeded(); }
+      return;
+    }
+    pendingTasks.fetch_add(tasks.size());
+    if (details::currentPool == this) {
+      localQueues[details::currentWorkerIndex]->pushRange(tasks);
+    } else {
+      // split into contiguous chunks so that every worker has something to start with
+      const auto chunkSize = (tasks.size() + localQueues.size() - 1) / localQueues.size();
+      for (std::size_t begin = 0; begin < tasks.size(); begin += chunkSize) {
+        const auto index = nextQueueIndex++ % localQueues.size();
+        localQueues[index]->pushRange(std::span{tasks}.subspan(begin, std::min(chunkSize, tasks.size() - begin)));
+      }
+    }
+    wakeWorkers(tasks.size());
+  }
+
+  /**
+  * Put task to the shared queue. When the queue is bounded and full, a worker of this pool runs the task instead of waiting for space.
+  */
+  inline void pushToQueue(details::Task &&task) {
+    if constexpr (requires { { queue.tryEnqueue(std::move(task)) } -> std::convertible_to<bool>; }) {
+      if (details::currentPool == this) {
+        if (!queue.tryEnqueue(std::move(task))) { runTask(task); }
+        return;
+      }
+    }
+    queue.enqueue(std::move(task));
+  }
+
+  inline void wakeWorkers(std::size_t taskCount) {
+    if (sleepingWorkers.load() == 0) { return; }
+    std::lock_guard lock{sleepMutex};
+    if (taskCount >= sleepingWorkers.load()) {
+      sleepCondition.notify_all();
+    } else {
+      for (std::size_t i = 0; i < taskCount; ++i) { sleepCondition.notify_one(); }
+    }
+  }
+
+  inline void stopWorkers() {
+    queue.shutdown();
+    std::lock_guard lock{sleepMutex};
+    sleepCondition.notify_all();
+  }
+
+  inline void runTask(details::Task &task) {
+    task();
+    if (unfinishedTasks.fetch_sub(1) == 1 && state == ThreadPoolState::FinishAndStop) { stopWorkers(); }
+  }
+
+  /**
+  * Start workers if tasks are waiting and no worker is idle.
+  */
+  inline void growIfNeeded() {
+    wakeElasticMonitor();
+    if (idleWorkers.load() != 0 || state != ThreadPoolState::Run) { return; }
+    const auto threadCount = getThreadCount();
+    if (threadCount >= elasticConfig.maxThreads) { return; }
+    // all workers are busy, so every unfinished task above their count is waiting in the queue
+    const auto unfinished = unfinishedTasks.load();
+    const auto queued = unfinished > threadCount ? unfinished - threadCount : 0;
+    if (queued == 0) { return; }
+    const auto sinceProgress = std::chrono::steady_clock::duration{std::chrono::steady_clock::now().time_since_epoch().count()
+                                                                   - lastQueueProgress.load(std::memory_order_relaxed)};
+    auto addCount = queued / elasticConfig.growQueueDepth;
+    if (addCount == 0 && (threadCount == 0 || sinceProgress >= elasticConfig.maxWaitTime)) { addCount = 1; }
+    if (addCount == 0) { return; }
+
+    std::lock_guard lock{elasticMutex};
+    for (auto &thread : retiredThreads) { thread.join(); }
+    retiredThreads.clear();
+    addCount = std::min(addCount, elasticConfig.maxThreads - std::min(elasticConfig.maxThreads, getThreadCount()));
+    for (std::size_t i = 0; i < addCount; ++i) {
+      elasticThreadCount.fetch_add(1);
+      const auto slot = freeElasticSlots.back();
+      freeElasticSlots.pop_back();
+      elasticThreads.emplace_back([this, slot] {
+        details::currentPool = this;
+        details::currentWorkerIndex = slot;
+        threadLoop(true);
+      });
+    }
+  }
+
+  /**
+  * @return true if tasks are waiting in the queue while all workers are busy and the pool could still grow
+  */
+  [[nodiscard]] inline bool isStarving() const {
+    const auto threadCount = getThreadCount();
+    return state == ThreadPoolState::Run && threadCount < elasticConfig.maxThreads && unfinishedTasks.load() > threadCount;
+  }
+
+  inline void wakeElasticMonitor() {
+    if (!monitorParked.load()) { return; }
+    std::lock_guard lock{monitorMutex};
+    monitorCondition.notify_one();
+  }
+
+  /**
+  * Body of the elastic mode monitor. Growth is otherwise only checked on submission and when a worker takes a task, so a pool whose
+  * workers are all stuck on long tasks wouldn't grow until something is submitted. The monitor sleeps while the pool isn't starving.
+  */
+  inline void elasticMonitorLoop() {
+    auto lock = std::unique_lock{monitorMutex};
+    while (!stopMonitor) {
+      // parked is set before the check, so a submission either sees it or its task is seen by the check
+      monitorParked.store(true);
+      if (!isStarving()) {
+        monitorCondition.wait(lock);
+        monitorParked.store(false);
+        continue;
+      }
+      monitorParked.store(false);
+      if (monitorCondition.wait_for(lock, elasticConfig.maxWaitTime, [this] { return stopMonitor; })) { return; }
+      lock.unlock();
+      growIfNeeded();
+      lock.lock();
+    }
+  }
+
+  /**
+  * Remove calling elastic worker from the pool unless there is more work for it.
+  * @return true if the worker should exit
+  */
+  [[nodiscard]] inline bool retireWorker() {
+    std::lock_guard lock{elasticMutex};
+    elasticThreadCount.fetch_sub(1);
+    // a task submitted right now might have counted on this worker
+    if (state != ThreadPoolState::Stop && !queue.isEmpty()) {
+      elasticThreadCount.fetch_add(1);
+      return false;
+    }
+    if (!joiningElasticThreads) {
+      const auto self = std::ranges::find(elasticThreads, std::this_thread::get_id(), &std::thread::get_id);
+      retiredThreads.splice(retiredThreads.end(), elasticThreads, self);
+      freeElasticSlots.emplace_back(details::currentWorkerIndex);
+    }
+    return true;
+  }
+
+  /**
+  * Worker loop of SharedQueue and Elastic modes.
+  * @param retireWhenIdle true for elastic workers above minThreads
+  */
+  inline void threadLoop(bool retireWhenIdle = false) {
+    const auto isElastic = mode == ThreadPoolMode::Elastic;
+    auto streak = details::PriorityStreak{};
     while (true) {
-      auto task = queue.dequeue();
+      if (!prioritizedTasks.isEmpty()) {
+        if (auto task = popPrioritized(streak, queue.isEmpty()); task.has_value()) {
+          runTask(*task);
+          continue;
+        }
+      }
+      if (isElastic) { idleWorkers.fetch_add(1); }
+      auto task = dequeueRegular(retireWhenIdle);
+      if (isElastic) {
+        idleWorkers.fetch_sub(1);
+        lastQueueProgress.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        // a submission might have seen this worker as idle and didn't grow the pool
+        if (task.has_value()) { growIfNeeded(); }
+      }
       if (task.has_value()) {
-        auto callable = std::move(task.value());
-        (*callable)();
-      } else {
+        countRegularTask(streak);
+        runTask(*task);
+      } else if (!retireWhenIdle || retireWorker()) {
         return;
       }
     }
   }
+
+  [[nodiscard]] inline std::optional<details::Task> dequeueRegular(bool withTimeout) {
+    if constexpr (requires { queue.dequeueFor(elasticConfig.idleTimeout); }) {
+      if (withTimeout) { return queue.dequeueFor(elasticConfig.idleTimeout); }
+    }
+    return queue.dequeue();
+  }
+
+  inline void countRegularTask(details::PriorityStreak &streak) {
+    streak.high = 0;
+    if (prioritizedTasks.hasLow()) { ++streak.waitedLow; }
+  }
+
+  [[nodiscard]] inline std::optional<details::Task> popOrSteal(std::size_t workerIndex) {
+    if (auto task = localQueues[workerIndex]->pop(); task.has_value()) { return task; }
+    if (!nodeQueues.empty()) { return popOrStealNodeLocal(workerIndex); }
+    for (std::size_t i = 1; i < localQueues.size(); ++i) {
+      if (auto task = localQueues[(workerIndex + i) % localQueues.size()]->steal(); task.has_value()) { return task; }
+    }
+    return std::nullopt;
+  }
+
+  /**
+  * Take a task from own node's queue, then steal from workers of the same node, then from other nodes.
+  */
+  [[nodiscard]] inline std::optional<details::Task> popOrStealNodeLocal(std::size_t workerIndex) {
+    const auto node = workerNodes[workerIndex];
+    if (auto task = nodeQueues[node]->steal(); task.has_value()) { return task; }
+    for (const auto victim : stealOrders[workerIndex]) {
+      if (auto task = localQueues[victim]->steal(); task.has_value()) { return task; }
+    }
+    for (std::size_t i = 1; i < nodeQueues.size(); ++i) {
+      if (auto task = nodeQueues[(node + i) % nodeQueues.size()]->steal(); task.has_value()) { return task; }
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] inline bool shouldStop() const {
+    const auto currentState = state.load();
+    return currentState == ThreadPoolState::Stop || (currentState == ThreadPoolState::FinishAndStop && unfinishedTasks.load() == 0);
+  }
+
+  inline void workStealingThreadLoop(std::size_t workerIndex) {
+    auto streak = details::PriorityStreak{};
+    while (state != ThreadPoolState::Stop) {
+      if (!prioritizedTasks.isEmpty()) {
+        if (auto task = popPrioritized(streak, false); task.has_value()) {
+          pendingTasks.fetch_sub(1);
+          runTask(*task);
+          continue;
+        }
+      }
+      if (auto task = popOrSteal(workerIndex); task.has_value()) {
+        pendingTasks.fetch_sub(1);
+        countRegularTask(streak);
+        runTask(*task);
+        continue;
+      }
+      if (!prioritizedTasks.isEmpty()) {
+        if (auto task = popPrioritized(streak, true); task.has_value()) {
+          pendingTasks.fetch_sub(1);
+          runTask(*task);
+          continue;
+        }
+      }
+      if (pendingTasks.load() > 0) {
+        // a task is being pushed or popped right now
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock lock{sleepMutex};
+      sleepingWorkers.fetch_add(1);
+      sleepCondition.wait(lock, [this] { return pendingTasks.load() > 0 || shouldStop(); });
+      sleepingWorkers.fetch_sub(1);
+      if (shouldStop()) { return; }
+    }
+  }
 };
+
+using ThreadPool = BasicThreadPool<>;
 }// namespace pf
 #endif// PF_COMMON_PARALLEL_THREADPOOL_H
@@ -0,0 +1,202 @@
+/**
+ * @file ThreadPoolStats.h
+ * @brief Statistics collected by ThreadPool when enabled.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_THREADPOOLSTATS_H
+#define PF_COMMON_PARALLEL_THREADPOOLSTATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <pf_common/parallel/CacheLine.h>
+#include <vector>
+
+namespace pf {
+/**
+ * @brief Histogram of durations with power of two buckets.
+ */
+struct DurationHistogram {
+  constexpr static std::size_t BUCKET_COUNT = 48;
+
+  /**
+   * Bucket i counts durations in [2^(i-1), 2^i) nanoseconds, bucket 0 counts zero durations and the last bucket everything longer.
+   */
+  std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+  std::uint64_t count = 0;
+  std::chrono::nanoseconds total{};
+  std::chrono::nanoseconds max{};
+
+  [[nodiscard]] static std::size_t bucketIndex(std::chrono::nanoseconds duration) {
+    return std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(std::max<std::int64_t>(0, duration.count()))),
+                                 BUCKET_COUNT - 1);
+  }
+  /**
+   * @return exclusive upper bound of durations counted in bucket
+   */
+  [[nodiscard]] static std::chrono::nanoseconds bucketUpperBound(std::size_t bucket) {
+    return std::chrono::nanoseconds{std::int64_t{1} << bucket};
+  }
+
+  [[nodiscard]] std::chrono::nanoseconds mean() const {
+    return count == 0 ? std::chrono::nanoseconds{} : total / static_cast<std::int64_t>(count);
+  }
+  /**
+   * @param fraction percentile in range [0, 1]
+   * @return upper bound of the bucket containing the percentile, precise up to a factor of 2
+   */
+  [[nodiscard]] std::chrono::nanoseconds percentile(double fraction) const {
+    if (count == 0) { return {}; }
+    const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(fraction * static_cast<double>(count) + 0.5));
+    std::uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+      accumulated += buckets[i];
+      if (accumulated >= target) { return std::min(bucketUpperBound(i), max); }
+    }
+    return max;
+  }
+};
+
+/**
+ * @brief Snapshot of ThreadPool's statistics.
+ */
+struct ThreadPoolStats {
+  struct Worker {
+    std::uint64_t tasksExecuted = 0;
+    std::chrono::nanoseconds busyTime{};
+    std::chrono::nanoseconds idleTime{};
+  };
+
+  /** Time since stats were enabled. */
+  std::chrono::nanoseconds collectionTime{};
+  std::uint64_t tasksSubmitted = 0;
+  std::uint64_t tasksExecuted = 0;
+  /** Tasks submitted and not started yet. */
+  std::size_t queueDepth = 0;
+  std::size_t peakQueueDepth = 0;
+  /** Time from submission to start of execution. */
+  DurationHistogram waitTime;
+  DurationHistogram executionTime;
+  /** Worker slots, in elastic mode a slot is reused by later workers. */
+  std::vector<Worker> workers;
+};
+
+namespace details {
+/**
+ * Add to a counter which has a single writer, cheaper than an atomic read-modify-write.
+ */
+template<typename T>
+void addSingleWriter(std::atomic<T> &counter, T value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/**
+ * Histogram which can be read concurrently, only a single thread may write at a time.
+ */
+class AtomicDurationHistogram {
+ public:
+  void record(std::chrono::nanoseconds duration) {
+    addSingleWriter(buckets[DurationHistogram::bucketIndex(duration)], std::uint64_t{1});
+    addSingleWriter(count, std::uint64_t{1});
+    addSingleWriter(total, duration.count());
+    if (duration.count() > max.load(std::memory_order_relaxed)) { max.store(duration.count(), std::memory_order_relaxed); }
+  }
+
+  void addTo(DurationHistogram &histogram) const {
+    for (std::size_t i = 0; i < DurationHistogram::BUCKET_COUNT; ++i) {
+      histogram.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+    }
+    histogram.count += count.load(std::memory_order_relaxed);
+    histogram.total += std::chrono::nanoseconds{total.load(std::memory_order_relaxed)};
+    histogram.max = std::max(histogram.max, std::chrono::nanoseconds{max.load(std::memory_order_relaxed)});
+  }
+
+ private:
+  std::array<std::atomic<std::uint64_t>, DurationHistogram::BUCKET_COUNT> buckets{};
+  std::atomic<std::uint64_t> count = 0;
+  std::atomic<std::int64_t> total = 0;
+  std::atomic<std::int64_t> max = 0;
+};
+
+/**
+ * Collects ThreadPool's statistics. Durations are recorded into per worker slots so workers don't share cache lines, each slot is
+ * written only by the worker owning it.
+ */
+class ThreadPoolStatsCollector {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  explicit ThreadPoolStatsCollector(std::size_t workerSlotCount)
+      : startTime(clock::now()), workerSlots(std::make_unique<WorkerSlot[]>(std::max<std::size_t>(1, workerSlotCount))),
+        workerSlotCount(std::max<std::size_t>(1, workerSlotCount)) {}
+
+  void onSubmit(std::size_t taskCount) {
+    submitted.fetch_add(taskCount, std::memory_order_relaxed);
+    const auto depth = queueDepth.fetch_add(taskCount, std::memory_order_relaxed) + taskCount;
+    auto currentPeak = peakQueueDepth.load(std::memory_order_relaxed);
+    while (depth > currentPeak && !peakQueueDepth.compare_exchange_weak(currentPeak, depth, std::memory_order_relaxed)) {}
+  }
+
+  void onStart(std::size_t workerSlot, std::chrono::nanoseconds waitTime) {
+    queueDepth.fetch_sub(1, std::memory_order_relaxed);
+    slot(workerSlot).waitTime.record(waitTime);
+  }
+
+  void onFinish(std::size_t workerSlot, std::chrono::nanoseconds executionTime) {
+    auto &workerStats = slot(workerSlot);
+    workerStats.executionTime.record(executionTime);
+    addSingleWriter(workerStats.tasksExecuted, std::uint64_t{1});
+    addSingleWriter(workerStats.busyTime, executionTime.count());
+  }
+
+  [[nodiscard]] ThreadPoolStats snapshot(std::size_t activeWorkerSlots) const {
+    auto result = ThreadPoolStats{};
+    result.collectionTime = clock::now() - startTime;
+    result.tasksSubmitted = submitted.load(std::memory_order_relaxed);
+    result.queueDepth = queueDepth.load(std::memory_order_relaxed);
+    result.peakQueueDepth = peakQueueDepth.load(std::memory_order_relaxed);
+    result.workers.resize(std::min(activeWorkerSlots, workerSlotCount));
+    for (std::size_t i = 0; i < workerSlotCount; ++i) {
+      const auto &workerStats = workerSlots[i];
+      workerStats.waitTime.addTo(result.waitTime);
+      workerStats.executionTime.addTo(result.executionTime);
+      const auto tasksExecuted = workerStats.tasksExecuted.load(std::memory_order_relaxed);
+      result.tasksExecuted += tasksExecuted;
+      if (i < result.workers.size()) {
+        auto &worker = result.workers[i];
+        worker.tasksExecuted = tasksExecuted;
+        worker.busyTime = std::chrono::nanoseconds{workerStats.busyTime.load(std::memory_order_relaxed)};
+        worker.idleTime = std::max(std::chrono::nanoseconds{}, result.collectionTime - worker.busyTime);
+      }
+    }
+    return result;
+  }
+
+ private:
+  struct alignas(CACHE_LINE_SIZE) WorkerSlot {
+    AtomicDurationHistogram waitTime;
+    AtomicDurationHistogram executionTime;
+    std::atomic<std::uint64_t> tasksExecuted = 0;
+    std::atomic<std::int64_t> busyTime = 0;
+  };
+
+  [[nodiscard]] WorkerSlot &slot(std::size_t index) { return workerSlots[std::min(index, workerSlotCount - 1)]; }
+
+  const clock::time_point startTime;
+  std::unique_ptr<WorkerSlot[]> workerSlots;
+  const std::size_t workerSlotCount;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> submitted = 0;
+  std::atomic<std::size_t> queueDepth = 0;
+  std::atomic<std::size_t> peakQueueDepth = 0;
+};
+}// namespace details
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_THREADPOOLSTATS_H
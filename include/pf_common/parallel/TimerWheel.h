@@ -0,0 +1,325 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timer wheel running delayed and periodic tasks on ThreadPool.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_TIMERWHEEL_H
+#define PF_COMMON_PARALLEL_TIMERWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <pf_common/parallel/InplaceTask.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pf {
+/**
+ * @brief Identifier of a timer scheduled in TimerWheel, stays unique even when the timer's storage is reused.
+ */
+struct TimerHandle {
+  std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+  std::uint32_t generation = 0;
+
+  bool operator==(const TimerHandle &) const = default;
+};
+
+/**
+ * @brief Scheduler of delayed and periodic tasks, which are posted to a thread pool when they are due.
+ *
+ * Timers are kept in 4 levels of 256 slots, level 0 slots are a single tick long and each higher level's slots are 256 times longer.
+ * Timers in higher levels are moved down one level at a time as their deadline gets closer. Scheduling and cancellation are O(1),
+ * timers are nodes of intrusive lists stored in a single vector and reused through a free list.
+ *
+ * Deadlines are rounded up to the tick, so a task never runs early and runs at most one tick (plus pool latency) late. A dedicated
+ * thread advances the wheel, it sleeps while no timer is scheduled. Tasks must not throw, same as with ThreadPool::post.
+ * @tparam Pool thread pool the tasks are posted to, it has to outlive the wheel
+ */
+template<typename Pool = ThreadPool>
+class BasicTimerWheel {
+ public:
+  using clock = std::chrono::steady_clock;
+  using Callback = InplaceTask<>;
+
+  constexpr static std::size_t LEVEL_BITS = 8;
+  constexpr static std::size_t SLOT_COUNT = std::size_t{1} << LEVEL_BITS;
+  constexpr static std::size_t LEVEL_COUNT = 4;
+  /** Timers further than this many ticks are parked in the top level and rescheduled when they get closer. */
+  constexpr static std::uint64_t MAX_TICK_DELTA = (std::uint64_t{1} << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+
+  /**
+   * @param pool pool running the tasks
+   * @param tickDuration resolution of the wheel
+   */
+  explicit BasicTimerWheel(Pool &pool, clock::duration tickDuration = std::chrono::milliseconds{1})
+      : pool(pool), tickDuration(std::max(tickDuration, clock::duration{1})), startTime(clock::now()) {
+    for (auto &level : slots) { level.fill(NIL); }
+    thread = std::thread{[this] { threadLoop(); }};
+  }
+  BasicTimerWheel(const BasicTimerWheel &) = delete;
+  BasicTimerWheel &operator=(const BasicTimerWheel &) = delete;
+  BasicTimerWheel(BasicTimerWheel &&) = delete;
+  BasicTimerWheel &operator=(BasicTimerWheel &&) = delete;
+
+  /**
+   * Stops the wheel, timers which are still scheduled are discarded.
+   */
+  ~BasicTimerWheel() {
+    {
+      std::lock_guard lock{mutex};
+      stopRequested = true;
+    }
+    condition.notify_one();
+    thread.join();
+  }
+
+  /**
+   * Run a task at a deadline.
+   * @param deadline time point at which the task is posted to the pool, a deadline in the past means the next tick
+   * @param callable task to be run
+   * @return handle for cancellation
+   */
+  TimerHandle scheduleAt(clock::time_point deadline, std::invocable auto &&callable) {
+    std::unique_lock lock{mutex};
+    return insert(deadlineTick(deadline), 0, Callback{std::forward<decltype(callable)>(callable)}, nullptr, lock);
+  }
+  /**
+   * Run a task after a delay.
+   * @param delay time after which the task is posted to the pool
+   * @param callable task to be run
+   * @return handle for cancellation
+   */
+  TimerHandle scheduleAfter(clock::duration delay, std::invocable auto &&callable) {
+    return scheduleAt(clock::now() + delay, std::forward<decltype(callable)>(callable));
+  }
+  /**
+   * Run a task periodically until it's cancelled, the first run is one period from now.
+   * Deadlines are computed from the previous deadline, not from the time the task actually ran, so they don't drift. If a run takes
+   * longer than the period the next one is started regardless and they run concurrently.
+   * @param period time between runs, rounded up to whole ticks
+   * @param callable task to be run
+   * @return handle for cancellation
+   */
+  template<std::invocable F>
+  TimerHandle scheduleEvery(clock::duration period, F &&callable) {
+    auto periodicCallback = std::make_shared<Callback>(std::forward<F>(callable));
+    std::unique_lock lock{mutex};
+    const auto periodTicks = std::max<std::uint64_t>(1, toTicksRoundedUp(period));
+    return insert(currentTick + periodTicks, periodTicks, Callback{}, std::move(periodicCallback), lock);
+  }
+
+  /**
+   * Cancel a timer. A task which was already posted to the pool isn't affected, for a periodic timer no further runs are started.
+   * @param handle handle of the timer
+   * @return true if the timer was scheduled and is now cancelled
+   */
+  bool cancel(TimerHandle handle) {
+    std::lock_guard lock{mutex};
+    if (handle.index >= nodes.size() || nodes[handle.index].generation != handle.generation || !nodes[handle.index].isScheduled) {
+      return false;
+    }
+    unlink(handle.index);
+    release(handle.index);
+    return true;
+  }
+
+  /**
+   * @return count of scheduled timers
+   */
+  [[nodiscard]] std::size_t size() const {
+    std::lock_guard lock{mutex};
+    return timerCount;
+  }
+  [[nodiscard]] bool isEmpty() const { return size() == 0; }
+  [[nodiscard]] clock::duration getTickDuration() const { return tickDuration; }
+
+ private:
+  constexpr static std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+  struct Node {
+    Callback callback;
+    /** Shared with tasks already posted to the pool, set only for periodic timers. */
+    std::shared_ptr<Callback> periodicCallback;
+    std::uint64_t expiry = 0;
+    std::uint64_t period = 0;
+    std::uint32_t prev = NIL;
+    std::uint32_t next = NIL;
+    /** Level * SLOT_COUNT + slot the node is linked in. */
+    std::uint32_t slot = 0;
+    std::uint32_t generation = 0;
+    bool isScheduled = false;
+  };
+
+  [[nodiscard]] std::uint64_t toTicksRoundedUp(clock::duration duration) const {
+    if (duration <= clock::duration::zero()) { return 0; }
+    return static_cast<std::uint64_t>((duration + tickDuration - clock::duration{1}) / tickDuration);
+  }
+  [[nodiscard]] std::uint64_t tickAt(clock::time_point time) const {
+    return static_cast<std::uint64_t>(std::max(clock::duration::zero(), time - startTime) / tickDuration);
+  }
+  [[nodiscard]] std::uint64_t deadlineTick(clock::time_point deadline) const {
+    return std::max(currentTick + 1, toTicksRoundedUp(deadline - startTime));
+  }
+
+  TimerHandle insert(std::uint64_t expiry, std::uint64_t period, Callback &&callback, std::shared_ptr<Callback> periodicCallback,
+                     std::unique_lock<std::mutex> &lock) {
+    const auto wasEmpty = timerCount == 0;
+    if (wasEmpty) {
+      // nothing is linked, the wheel can skip the ticks it slept through
+      const auto tickNow = tickAt(clock::now());
+      if (tickNow > currentTick) {
+        if (period != 0) { expiry += tickNow - currentTick; }
+        currentTick = tickNow;
+        expiry = std::max(expiry, currentTick + 1);
+      }
+    }
+    const auto index = acquire();
+    auto &node = nodes[index];
+    node.callback = std::move(callback);
+    node.periodicCallback = std::move(periodicCallback);
+    node.expiry = expiry;
+    node.period = period;
+    node.isScheduled = true;
+    link(index);
+    ++timerCount;
+    const auto handle = TimerHandle{index, node.generation};
+    lock.unlock();
+    if (wasEmpty) { condition.notify_one(); }
+    return handle;
+  }
+
+  [[nodiscard]] std::uint32_t acquire() {
+    if (freeHead != NIL) {
+      const auto index = freeHead;
+      freeHead = nodes[index].next;
+      return index;
+    }
+    nodes.emplace_back();
+    return static_cast<std::uint32_t>(nodes.size() - 1);
+  }
+  void release(std::uint32_t index) {
+    auto &node = nodes[index];
+    node.callback = Callback{};
+    node.periodicCallback = nullptr;
+    node.isScheduled = false;
+    ++node.generation;
+    node.prev = NIL;
+    node.next = freeHead;
+    freeHead = index;
+    --timerCount;
+  }
+
+  void link(std::uint32_t index) {
+    auto &node = nodes[index];
+    const auto delta = node.expiry > currentTick ? std::min(node.expiry - currentTick, MAX_TICK_DELTA) : 0;
+    const auto slotExpiry = currentTick + delta;
+    std::size_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (std::uint64_t{1} << (LEVEL_BITS * (level + 1)))) { ++level; }
+    const auto slot = static_cast<std::uint32_t>(level * SLOT_COUNT + ((slotExpiry >> (LEVEL_BITS * level)) & (SLOT_COUNT - 1)));
+    auto &head = slots[level][slot % SLOT_COUNT];
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = head;
+    if (head != NIL) { nodes[head].prev = index; }
+    head = index;
+  }
+  void unlink(std::uint32_t index) {
+    auto &node = nodes[index];
+    if (node.prev != NIL) {
+      nodes[node.prev].next = node.next;
+    } else {
+      slots[node.slot / SLOT_COUNT][node.slot % SLOT_COUNT] = node.next;
+    }
+    if (node.next != NIL) { nodes[node.next].prev = node.prev; }
+  }
+
+  /**
+   * Detach all nodes of a slot.
+   * @return head of the detached list
+   */
+  [[nodiscard]] std::uint32_t takeSlot(std::size_t level, std::size_t slot) { return std::exchange(slots[level][slot], NIL); }
+
+  /**
+   * Move to the next tick, move timers of higher levels whose time range begins and collect due tasks.
+   */
+  void advance() {
+    ++currentTick;
+    for (std::size_t level = 1; level < LEVEL_COUNT; ++level) {
+      if ((currentTick & ((std::uint64_t{1} << (LEVEL_BITS * level)) - 1)) != 0) { break; }
+      for (auto index = takeSlot(level, (currentTick >> (LEVEL_BITS * level)) & (SLOT_COUNT - 1)); index != NIL;) {
+        const auto next = nodes[index].next;
+        link(index);
+        index = next;
+      }
+    }
+    for (auto index = takeSlot(0, currentTick & (SLOT_COUNT - 1)); index != NIL;) {
+      auto &node = nodes[index];
+      const auto next = node.next;
+      if (node.expiry > currentTick) {
+        link(index);
+      } else if (node.period != 0) {
+        dueTasks.emplace_back([callback = node.periodicCallback] { (*callback)(); });
+        node.expiry = std::max(node.expiry + node.period, currentTick + 1);
+        link(index);
+      } else {
+        dueTasks.emplace_back(std::move(node.callback));
+        release(index);
+      }
+      index = next;
+    }
+  }
+
+  void threadLoop() {
+    auto tasksToPost = std::vector<Callback>{};
+    std::unique_lock lock{mutex};
+    while (!stopRequested) {
+      if (timerCount == 0) {
+        condition.wait(lock, [this] { return stopRequested || timerCount != 0; });
+        continue;
+      }
+      const auto targetTick = tickAt(clock::now());
+      if (targetTick <= currentTick) {
+        condition.wait_until(lock, startTime + tickDuration * static_cast<clock::rep>(currentTick + 1));
+        continue;
+      }
+      while (currentTick < targetTick && timerCount != 0) { advance(); }
+      currentTick = std::max(currentTick, targetTick);
+      if (dueTasks.empty()) { continue; }
+      std::swap(tasksToPost, dueTasks);
+      // posting doesn't need the lock, scheduling and cancellation aren't blocked meanwhile
+      lock.unlock();
+      for (auto &task : tasksToPost) { pool.post(std::move(task)); }
+      tasksToPost.clear();
+      lock.lock();
+    }
+  }
+
+  Pool &pool;
+  const clock::duration tickDuration;
+  const clock::time_point startTime;
+  mutable std::mutex mutex;
+  std::condition_variable condition;
+  std::array<std::array<std::uint32_t, SLOT_COUNT>, LEVEL_COUNT> slots;
+  std::vector<Node> nodes;
+  std::uint32_t freeHead = NIL;
+  std::size_t timerCount = 0;
+  std::uint64_t currentTick = 0;
+  std::vector<Callback> dueTasks;
+  bool stopRequested = false;
+  std::thread thread;
+};
+
+using TimerWheel = BasicTimerWheel<>;
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_TIMERWHEEL_H
@@ -0,0 +1,293 @@
+/**
+ * @file TreeAlgorithms.h
+ * @brief Parallel traversals of pf::Tree running on a ThreadPool.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_TREEALGORITHMS_H
+#define PF_COMMON_PARALLEL_TREEALGORITHMS_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <pf_common/containers/Tree.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace pf {
+namespace details {
+/**
+ * Count of nodes a traversal visits before it starts sharing its subtrees with idle workers when grain size is selected automatically.
+ */
+inline constexpr std::size_t PARALLEL_TREE_DEFAULT_GRAIN_SIZE = 512;
+
+/**
+ * Shared state of a parallel tree traversal. Every participant traverses its part of the tree depth first using a local stack of
+ * items and once in grainSize visited nodes it checks whether another participant could take some work - the caller waiting for
+ * the others or room for another helper task on the pool. If so, the bottom half of the local stack - items closest to the root,
+ * which tend to be the biggest subtrees - is moved to the shared queue and a helper is posted for it.
+ *
+ * Helpers return as soon as the shared queue is empty, so a traversal which doesn't share its work doesn't occupy the pool's workers.
+ * @tparam Pool pool the helpers are posted to
+ * @tparam Item unit of work, usually a node and data needed to process it
+ * @tparam ProcessFnc callable (Item &&, std::vector<Item> &localStack) which processes an item and pushes items it creates
+ */
+template<typename Pool, typename Item, typename ProcessFnc>
+struct ParallelTreeState : std::enable_shared_from_this<ParallelTreeState<Pool, Item, ProcessFnc>> {
+  ParallelTreeState(Pool &pool, ProcessFnc &processFnc, Item &&root, std::size_t grainSize)
+      : pool(pool), processFnc(processFnc), grainSize(grainSize), maxHelperCount(pool.getThreadCount()) {
+    sharedItems.emplace_back(std::move(root));
+  }
+
+  /**
+   * Process items until the whole tree is done, called by the thread starting the traversal.
+   */
+  void run() { process(true); }
+
+  void rethrowIfFailed() {
+    if (failed.load()) { std::rethrow_exception(exception); }
+  }
+
+ private:
+  /**
+   * Process items, helpers stop when there are no shared items left. Caller's processFnc and pool are only accessed while an item
+   * is being processed, so late helpers can run after the caller returned.
+   * @param isCaller true for the thread which started the traversal
+   */
+  void process(bool isCaller) {
+    auto localStack = std::vector<Item>{};
+    while (takeWork(localStack, isCaller)) {
+      std::size_t visitedCount = 0;
+      while (!localStack.empty()) {
+        auto item = std::move(localStack.back());
+        localStack.pop_back();
+        if (failed.load(std::memory_order_relaxed)) { continue; }
+        try {
+          processFnc(std::move(item), localStack);
+        } catch (...) {
+          std::lock_guard lock{mutex};
+          if (!failed.exchange(true)) { exception = std::current_exception(); }
+        }
+        if (++visitedCount % grainSize == 0 && canShare()) { share(localStack); }
+      }
+      finishWork();
+    }
+  }
+
+  [[nodiscard]] bool canShare() const {
+    return callerWaiting.load(std::memory_order_relaxed) || helperCount.load(std::memory_order_relaxed) < maxHelperCount;
+  }
+
+  /**
+   * Take an item from the shared queue, the caller waits for one until all participants are done.
+   * @return false if there is no more work for this participant
+   */
+  [[nodiscard]] bool takeWork(std::vector<Item> &localStack, bool isCaller) {
+    std::unique_lock lock{mutex};
+    if (isCaller) {
+      while (sharedItems.empty() && activeCount != 0) {
+        callerWaiting.store(true, std::memory_order_relaxed);
+        condition.wait(lock);
+        callerWaiting.store(false, std::memory_order_relaxed);
+      }
+    }
+    if (sharedItems.empty()) {
+      if (!isCaller) { helperCount.fetch_sub(1, std::memory_order_relaxed); }
+      return false;
+    }
+    localStack.emplace_back(std::move(sharedItems.back()));
+    sharedItems.pop_back();
+    ++activeCount;
+    return true;
+  }
+
+  void finishWork() {
+    std::lock_guard lock{mutex};
+    if (--activeCount == 0 && sharedItems.empty()) { condition.notify_all(); }
+  }
+
+  void share(std::vector<Item> &localStack) {
+    if (localStack.size() < 2) { return; }
+    const auto shareCount = localStack.size() / 2;
+    auto postHelper = false;
+    {
+      std::lock_guard lock{mutex};
+      std::ranges::move(localStack.begin(), localStack.begin() + shareCount, std::back_inserter(sharedItems));
+      if (helperCount.load(std::memory_order_relaxed) < maxHelperCount) {
+        helperCount.fetch_add(1, std::memory_order_relaxed);
+        postHelper = true;
+      }
+    }
+    localStack.erase(localStack.begin(), localStack.begin() + shareCount);
+    condition.notify_all();
+    if (postHelper) { pool.post([self = this->shared_from_this()] { self->process(false); }); }
+  }
+
+  Pool &pool;
+  ProcessFnc &processFnc;
+  const std::size_t grainSize;
+  const std::size_t maxHelperCount;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<Item> sharedItems;
+  std::size_t activeCount = 0;
+  std::atomic<std::size_t> helperCount = 0;
+  std::atomic<bool> callerWaiting = false;
+  std::atomic<bool> failed = false;
+  std::exception_ptr exception;
+};
+
+/**
+ * Run a traversal starting at root on the pool, the calling thread takes part in it.
+ */
+template<template<typename> typename Queue, typename Item>
+void parallelTreeTraversal(BasicThreadPool<Queue> &pool, Item &&root, std::size_t grainSize, auto &&processFnc) {
+  if (grainSize == 0) { grainSize = PARALLEL_TREE_DEFAULT_GRAIN_SIZE; }
+  using State =
+      ParallelTreeState<BasicThreadPool<Queue>, std::remove_cvref_t<Item>, std::remove_reference_t<decltype(processFnc)>>;
+  auto state = std::make_shared<State>(pool, processFnc, std::forward<Item>(root), grainSize);
+  state->run();
+  state->rethrowIfFailed();
+}
+
+template<template<typename> typename Queue, typename N, typename F>
+void parallelDepthFirstImpl(BasicThreadPool<Queue> &pool, N &node, F &fn, std::size_t grainSize) {
+  parallelTreeTraversal(pool, &node, grainSize, [&fn](N *current, std::vector<N *> &localStack) {
+    std::invoke(fn, *current);
+    auto children = current->children();
+    for (auto i = current->childrenSize(); i > 0; --i) { localStack.emplace_back(&children[i - 1]); }
+  });
+}
+
+template<typename N, typename R>
+struct FoldJoin {
+  FoldJoin(N &node, std::shared_ptr<FoldJoin> parent, std::size_t index)
+      : node(node), results(node.childrenSize()), pendingCount(node.childrenSize()), parent(std::move(parent)), index(index) {}
+
+  N &node;
+  std::vector<R> results;
+  std::atomic<std::size_t> pendingCount;
+  std::shared_ptr<FoldJoin> parent;
+  std::size_t index;
+};
+
+template<template<typename> typename Queue, typename R, typename N, typename F>
+R parallelFoldPostOrderImpl(BasicThreadPool<Queue> &pool, N &node, F &fn, std::size_t grainSize) {
+  using Join = FoldJoin<N, R>;
+  struct Item {
+    N *node;
+    std::shared_ptr<Join> parent;
+    std::size_t index;
+  };
+  auto rootResult = R{};
+  // the last finished child completes its parent, so results flow up without anyone waiting
+  const auto complete = [&](R &&result, std::shared_ptr<Join> parent, std::size_t index) {
+    while (parent != nullptr) {
+      parent->results[index] = std::move(result);
+      if (parent->pendingCount.fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+      result = std::invoke(fn, parent->node, std::span<R>{parent->results});
+      index = parent->index;
+      parent = std::move(parent->parent);
+    }
+    rootResult = std::move(result);
+  };
+  parallelTreeTraversal(pool, Item{&node, nullptr, 0}, grainSize, [&](Item &&item, std::vector<Item> &localStack) {
+    const auto childCount = item.node->childrenSize();
+    if (childCount == 0) {
+      complete(std::invoke(fn, *item.node, std::span<R>{}), std::move(item.parent), item.index);
+      return;
+    }
+    auto join = std::make_shared<Join>(*item.node, std::move(item.parent), item.index);
+    auto children = item.node->children();
+    for (auto i = childCount; i > 0; --i) { localStack.emplace_back(Item{&children[i - 1], join, i - 1}); }
+  });
+  return rootResult;
+}
+}// namespace details
+
+/**
+ * Call fn for each node of the subtree in parallel on the pool. A node is always visited before its descendants, there is no order
+ * among different subtrees. Subtrees are handed to helper tasks on the pool only after a task visited at least grainSize nodes, at
+ * most one helper per worker of the pool. Small trees are traversed by the calling thread alone and helpers exit once there is no
+ * shared work, so the traversal doesn't hold the pool's workers while it can't use them.
+ * @param pool pool to run on, calling thread takes part in the work
+ * @param node root of the traversed subtree
+ * @param fn callable invoked with a reference to each node, it must not modify children of nodes which are still to be visited
+ * @param grainSize minimal count of nodes visited by a task before it shares its work, selected automatically when 0
+ */
+template<template<typename> typename Queue, typename T, std::invocable<Node<T> &> F>
+void parallelDepthFirst(BasicThreadPool<Queue> &pool, Node<T> &node, F &&fn, std::size_t grainSize = 0) {
+  details::parallelDepthFirstImpl(pool, node, fn, grainSize);
+}
+template<template<typename> typename Queue, typename T, std::invocable<const Node<T> &> F>
+void parallelDepthFirst(BasicThreadPool<Queue> &pool, const Node<T> &node, F &&fn, std::size_t grainSize = 0) {
+  details::parallelDepthFirstImpl(pool, node, fn, grainSize);
+}
+template<template<typename> typename Queue, typename T, std::invocable<Node<T> &> F>
+void parallelDepthFirst(BasicThreadPool<Queue> &pool, Tree<T> &tree, F &&fn, std::size_t grainSize = 0) {
+  if (!tree.hasRoot()) { return; }
+  details::parallelDepthFirstImpl(pool, tree.getRoot(), fn, grainSize);
+}
+template<template<typename> typename Queue, typename T, std::invocable<const Node<T> &> F>
+void parallelDepthFirst(BasicThreadPool<Queue> &pool, const Tree<T> &tree, F &&fn, std::size_t grainSize = 0) {
+  if (!tree.hasRoot()) { return; }
+  details::parallelDepthFirstImpl(pool, tree.getRoot(), fn, grainSize);
+}
+
+/**
+ * Bottom up fold of the subtree in parallel on the pool, e.g. for subtree sizes or bounds. The result of a node is computed by fn
+ * from the node and results of its children, after all of them are done. Work is shared between workers the same way as in
+ * parallelDepthFirst.
+ * @code
+ * const auto size = parallelFoldPostOrder<std::size_t>(pool, tree, [](const Node<int> &, std::span<std::size_t> children) {
+ *   return std::accumulate(children.begin(), children.end(), std::size_t{1});
+ * });
+ * @endcode
+ * @tparam R result type
+ * @param pool pool to run on, calling thread takes part in the work
+ * @param node root of the folded subtree
+ * @param fn callable (node, std::span<R> childResults) -> R, child results are in order of the children
+ * @param grainSize minimal count of nodes visited by a task before it shares its work, selected automatically when 0
+ * @return result of the root
+ */
+template<std::default_initializable R, template<typename> typename Queue, typename T, typename F>
+  requires std::movable<R> && std::convertible_to<std::invoke_result_t<F &, Node<T> &, std::span<R>>, R>
+[[nodiscard]] R parallelFoldPostOrder(BasicThreadPool<Queue> &pool, Node<T> &node, F &&fn, std::size_t grainSize = 0) {
+  return details::parallelFoldPostOrderImpl<Queue, R>(pool, node, fn, grainSize);
+}
+template<std::default_initializable R, template<typename> typename Queue, typename T, typename F>
+  requires std::movable<R> && std::convertible_to<std::invoke_result_t<F &, const Node<T> &, std::span<R>>, R>
+[[nodiscard]] R parallelFoldPostOrder(BasicThreadPool<Queue> &pool, const Node<T> &node, F &&fn, std::size_t grainSize = 0) {
+  return details::parallelFoldPostOrderImpl<Queue, R>(pool, node, fn, grainSize);
+}
+/**
+ * @return result of the root or default constructed R for an empty tree
+ */
+template<std::default_initializable R, template<typename> typename Queue, typename T, typename F>
+  requires std::movable<R> && std::convertible_to<std::invoke_result_t<F &, Node<T> &, std::span<R>>, R>
+[[nodiscard]] R parallelFoldPostOrder(BasicThreadPool<Queue> &pool, Tree<T> &tree, F &&fn, std::size_t grainSize = 0) {
+  if (!tree.hasRoot()) { return R{}; }
+  return details::parallelFoldPostOrderImpl<Queue, R>(pool, tree.getRoot(), fn, grainSize);
+}
+/**
+ * @return result of the root or default constructed R for an empty tree
+ */
+template<std::default_initializable R, template<typename> typename Queue, typename T, typename F>
+  requires std::movable<R> && std::convertible_to<std::invoke_result_t<F &, const Node<T> &, std::span<R>>, R>
+[[nodiscard]] R parallelFoldPostOrder(BasicThreadPool<Queue> &pool, const Tree<T> &tree, F &&fn, std::size_t grainSize = 0) {
+  if (!tree.hasRoot()) { return R{}; }
+  return details::parallelFoldPostOrderImpl<Queue, R>(pool, tree.getRoot(), fn, grainSize);
+}
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_TREEALGORITHMS_H
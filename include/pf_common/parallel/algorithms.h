@@ -0,0 +1,177 @@
+/**
+ * @file algorithms.h
+ * @brief Parallel versions of common loops running on a ThreadPool.
+ * @author Petr Flajšingr
+ * @date 17.10.26
+ */
+
+#ifndef PF_COMMON_PARALLEL_ALGORITHMS_H
+#define PF_COMMON_PARALLEL_ALGORITHMS_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pf_common/parallel/ThreadPool.h>
+#include <ranges>
+#include <vector>
+
+namespace pf {
+namespace details {
+/**
+ * Count of chunks per worker when grain size is selected automatically - more chunks than workers balance uneven work.
+ */
+inline constexpr std::size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+template<typename ChunkFnc>
+struct ParallelChunksState {
+  ParallelChunksState(ChunkFnc &chunkFnc, std::size_t count, std::size_t grainSize)
+      : chunkFnc(chunkFnc), count(count), grainSize(grainSize), chunkCount((count + grainSize - 1) / grainSize) {}
+
+  /**
+   * Run chunks until there are none left. Caller's chunkFnc is only accessed while a chunk is claimed, so late helpers can run after
+   * the caller returned.
+   */
+  void runChunks() {
+    for (auto chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1)) {
+      if (!failed.load(std::memory_order_relaxed)) {
+        try {
+          const auto begin = chunk * grainSize;
+          chunkFnc(chunk, begin, std::min(begin + grainSize, count));
+        } catch (...) {
+          std::lock_guard lock{exceptionMutex};
+          if (!failed.exchange(true)) { exception = std::current_exception(); }
+        }
+      }
+      if (finishedChunks.fetch_add(1) + 1 == chunkCount) { finishedChunks.notify_all(); }
+    }
+  }
+
+  void wait() {
+    for (auto finished = finishedChunks.load(); finished != chunkCount; finished = finishedChunks.load()) { finishedChunks.wait(finished); }
+    if (failed.load()) { std::rethrow_exception(exception); }
+  }
+
+  ChunkFnc &chunkFnc;
+  const std::size_t count;
+  const std::size_t grainSize;
+  const std::size_t chunkCount;
+  std::atomic<std::size_t> nextChunk = 0;
+  std::atomic<std::size_t> finishedChunks = 0;
+  std::atomic<bool> failed = false;
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+};
+
+[[nodiscard]] inline std::size_t selectGrainSize(std::size_t count, std::size_t threadCount, std::size_t grainSize) {
+  if (grainSize != 0) { return grainSize; }
+  const auto chunkCount = std::max<std::size_t>(1, threadCount * PARALLEL_CHUNKS_PER_THREAD);
+  return std::max<std::size_t>(1, (count + chunkCount - 1) / chunkCount);
+}
+
+/**
+ * Split [0, count) into chunks and run them on the pool. The calling thread processes chunks too and only waits for chunks which are
+ * already running, so it's safe to call from inside of a pool's task.
+ * @param chunkFnc callable (chunkIndex, begin, end)
+ */
+template<template<typename> typename Queue>
+void parallelChunks(BasicThreadPool<Queue> &pool, std::size_t count, std::size_t grainSize, auto &&chunkFnc) {
+  if (count == 0) { return; }
+  grainSize = selectGrainSize(count, pool.getThreadCount(), grainSize);
+  const auto chunkCount = (count + grainSize - 1) / grainSize;
+  if (chunkCount == 1 || pool.getThreadCount() == 0) {
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+      const auto begin = chunk * grainSize;
+      chunkFnc(chunk, begin, std::min(begin + grainSize, count));
+    }
+    return;
+  }
+  auto state = std::make_shared<ParallelChunksState<std::remove_reference_t<decltype(chunkFnc)>>>(chunkFnc, count, grainSize);
+  const auto helperCount = std::min(pool.getThreadCount(), chunkCount - 1);
+  pool.postBulk(std::views::iota(std::size_t{0}, helperCount)
+                | std::views::transform([&state](std::size_t) { return [state] { state->runChunks(); }; }));
+  state->runChunks();
+  state->wait();
+}
+}// namespace details
+
+/**
+ * Call fn for each element of the range, elements are processed in parallel on the pool.
+ * @param pool pool to run on, calling thread takes part in the work
+ * @param range processed range
+ * @param fn callable invoked with a reference to each element
+ * @param grainSize count of elements processed by one task, selected automatically when 0
+ */
+template<template<typename> typename Queue, std::ranges::random_access_range R,
+         std::invocable<std::ranges::range_reference_t<R>> F>
+  requires std::ranges::sized_range<R>
+void parallelFor(BasicThreadPool<Queue> &pool, R &&range, F &&fn, std::size_t grainSize = 0) {
+  const auto first = std::ranges::begin(range);
+  details::parallelChunks(pool, std::ranges::size(range), grainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::ranges::for_each(first + begin, first + end, std::ref(fn));
+  });
+}
+
+/**
+ * Reduce the range in parallel on the pool.
+ * Elements of each chunk are reduced in order and the partial results are then combined in order of the chunks, so op has to be
+ * associative but doesn't need to be commutative. Reduction of a chunk starts from its first element converted to T.
+ * @param pool pool to run on, calling thread takes part in the work
+ * @param range reduced range
+ * @param init initial value, it's used exactly once
+ * @param op binary reduction
+ * @param grainSize count of elements processed by one task, selected automatically when 0
+ * @return reduced value
+ */
+template<template<typename> typename Queue, std::ranges::random_access_range R, typename T, typename BinaryOp = std::plus<>>
+  requires std::ranges::sized_range<R> && std::constructible_from<T, std::ranges::range_reference_t<R>>
+           && std::invocable<BinaryOp &, T, std::ranges::range_reference_t<R>> && std::invocable<BinaryOp &, T, T>
+[[nodiscard]] T parallelReduce(BasicThreadPool<Queue> &pool, R &&range, T init, BinaryOp op = {}, std::size_t grainSize = 0) {
+  const auto first = std::ranges::begin(range);
+  const auto count = static_cast<std::size_t>(std::ranges::size(range));
+  grainSize = details::selectGrainSize(count, pool.getThreadCount(), grainSize);
+  auto partials = std::vector<std::optional<T>>((count + grainSize - 1) / grainSize);
+  details::parallelChunks(pool, count, grainSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    auto partial = static_cast<T>(first[begin]);
+    for (auto i = begin + 1; i < end; ++i) { partial = std::invoke(op, std::move(partial), first[i]); }
+    partials[chunk] = std::move(partial);
+  });
+  for (auto &partial : partials) { init = std::invoke(op, std::move(init), std::move(*partial)); }
+  return init;
+}
+
+/**
+ * Transform elements of the input range into the output range in parallel on the pool.
+ * @param pool pool to run on, calling thread takes part in the work
+ * @param input input range
+ * @param output output range, must have at least as many elements as input
+ * @param fn transformation
+ * @param grainSize count of elements processed by one task, selected automatically when 0
+ * @return iterator to the output element after the last written one, std::ranges::dangling for rvalue output
+ */
+template<template<typename> typename Queue, std::ranges::random_access_range In, std::ranges::random_access_range Out,
+         std::invocable<std::ranges::range_reference_t<In>> F>
+  requires std::ranges::sized_range<In>
+           && std::indirectly_writable<std::ranges::iterator_t<Out>, std::invoke_result_t<F &, std::ranges::range_reference_t<In>>>
+std::ranges::borrowed_iterator_t<Out> parallelTransform(BasicThreadPool<Queue> &pool, In &&input, Out &&output, F &&fn, std::size_t grainSize = 0) {
+  const auto inFirst = std::ranges::begin(input);
+  const auto outFirst = std::ranges::begin(output);
+  const auto count = static_cast<std::size_t>(std::ranges::size(input));
+  details::parallelChunks(pool, count, grainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::ranges::transform(inFirst + begin, inFirst + end, outFirst + begin, std::ref(fn));
+  });
+  if constexpr (std::ranges::borrowed_range<Out>) {
+    return outFirst + count;
+  } else {
+    return std::ranges::dangling{};
+  }
+}
+}// namespace pf
+
+#endif//PF_COMMON_PARALLEL_ALGORITHMS_H
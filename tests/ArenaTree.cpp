@@ -0,0 +1,134 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <pf_common/containers/ArenaTree.h>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TreeTestUtils.h"
+
+using namespace pf;
+
+TEST_CASE("ArenaTree iteration", "[ArenaTree]") {
+  auto tree = makeTree<ArenaTree<int>>();
+  REQUIRE(tree.size() == 7);
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+  REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 1, 2, 3, 4, 5, 6});
+  REQUIRE(collect(tree.getRoot().children() | std::views::transform([](const auto &node) { return *node; })) == std::vector{1, 2, 3});
+
+  SECTION("subtree") {
+    auto &node1 = *tree.getRoot().children().begin();
+    REQUIRE(collect(node1.iterDepthFirst()) == std::vector{1, 4, 5});
+    REQUIRE(collect(node1.iterBreadthFirst()) == std::vector{1, 4, 5});
+  }
+  SECTION("const and nodes") {
+    const auto &constTree = tree;
+    REQUIRE(collect(constTree.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+    auto childCounts = std::vector<std::size_t>{};
+    for (const auto &node : constTree.iterNodesBreadthFirst()) { childCounts.emplace_back(node.childrenSize()); }
+    REQUIRE(childCounts == std::vector<std::size_t>{3, 2, 0, 1, 0, 0, 0});
+  }
+  SECTION("modification through iteration") {
+    for (auto &value : tree.iterDepthFirst()) { value *= 10; }
+    REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 10, 40, 50, 20, 30, 60});
+  }
+}
+
+TEST_CASE("ArenaTree insert, remove and sort children", "[ArenaTree]") {
+  auto tree = makeTree<ArenaTree<int>>();
+  auto &root = tree.getRoot();
+  root.insertChild(0, 7);
+  root.insertChild(2, 8);
+  REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 7, 1, 8, 2, 3, 4, 5, 6});
+
+  root.removeChild(1);
+  REQUIRE(tree.size() == 6);
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 7, 8, 2, 3, 6});
+
+  root.sortChildren([](int lhs, int rhs) { return lhs > rhs; });
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 8, 7, 3, 6, 2});
+
+  // freed nodes are reused
+  const auto &newNode = root.appendChild(9);
+  REQUIRE(newNode.getIndex() < 7);
+  REQUIRE(&tree.getNode(newNode.getIndex()) == &newNode);
+
+  root.clearChildren();
+  REQUIRE(tree.size() == 1);
+  REQUIRE(root.childrenSize() == 0);
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0});
+}
+
+TEST_CASE("ArenaTree keeps node references when growing and moving", "[ArenaTree]") {
+  auto tree = ArenaTree<int>{0};
+  auto *node = &tree.getRoot();
+  auto nodes = std::vector<ArenaNode<int> *>{node};
+  for (int i = 1; i < 10000; ++i) {
+    node = &nodes[static_cast<std::size_t>(i) / 2]->appendChild(i);
+    nodes.emplace_back(node);
+  }
+  auto movedTree = std::move(tree);
+  REQUIRE_FALSE(tree.hasRoot());
+  REQUIRE(movedTree.size() == 10000);
+  for (int i = 0; i < 10000; ++i) { REQUIRE(**nodes[static_cast<std::size_t>(i)] == i); }
+  REQUIRE(&movedTree.getRoot() == nodes.front());
+  REQUIRE(std::ranges::distance(movedTree.iterDepthFirst()) == 10000);
+}
+
+TEST_CASE("ArenaTree with non trivial values", "[ArenaTree]") {
+  auto tree = ArenaTree<std::string>{std::string{"root"}};
+  auto &child = tree.getRoot().appendChild(std::string(100, 'a'));
+  child.appendChild(std::string(100, 'b'));
+  tree.getRoot().appendChild(std::string(100, 'c'));
+  tree.getRoot().removeChild(0);
+  REQUIRE(tree.size() == 2);
+
+  tree.initRoot(std::string{"new root"});
+  REQUIRE(tree.size() == 1);
+  REQUIRE(*tree.getRoot() == "new root");
+  tree.clear();
+  REQUIRE_FALSE(tree.hasRoot());
+  REQUIRE(tree.size() == 0);
+}
+
+namespace {
+struct ThrowingCopy {
+  explicit ThrowingCopy(bool throwOnCopy) : throwOnCopy(throwOnCopy) {}
+  ThrowingCopy(const ThrowingCopy &other) : throwOnCopy(other.throwOnCopy) {
+    if (throwOnCopy) { throw std::runtime_error{"copy"}; }
+  }
+  bool throwOnCopy;
+};
+}// namespace
+
+TEST_CASE("ArenaTree releases node slot when value construction throws", "[ArenaTree]") {
+  auto tree = ArenaTree<ThrowingCopy>{ThrowingCopy{false}};
+  auto &root = tree.getRoot();
+  const auto throwing = ThrowingCopy{true};
+  const auto valid = ThrowingCopy{false};
+
+  REQUIRE_THROWS_AS(root.appendChild(throwing), std::runtime_error);
+  REQUIRE(tree.size() == 1);
+  REQUIRE(root.childrenSize() == 0);
+  REQUIRE(root.appendChild(valid).getIndex() == 1);
+
+  root.appendChild(valid);
+  root.removeChild(0);
+  REQUIRE_THROWS_AS(root.appendChild(throwing), std::runtime_error);
+  REQUIRE(tree.size() == 2);
+  REQUIRE(root.appendChild(valid).getIndex() == 1);
+}
+
+TEST_CASE("ArenaTree rejects reservation above 32 bit indices", "[ArenaTree]") {
+  auto tree = ArenaTree<int>{};
+  if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+    REQUIRE_THROWS_AS(tree.reserve(ArenaTree<int>::max_size() + 1), std::length_error);
+    REQUIRE_THROWS_AS(tree.reserve(std::size_t{1} << 40), std::length_error);
+  }
+  tree.reserve(100);
+  REQUIRE(tree.size() == 0);
+}
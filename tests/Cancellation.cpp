@@ -0,0 +1,118 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <pf_common/parallel/ThreadPool.h>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+namespace {
+/**
+ * Task running until stop is requested, returns count of iterations.
+ */
+int runUntilStopped(std::stop_token token) {
+  int iterations = 0;
+  while (!token.stop_requested()) {
+    ++iterations;
+    std::this_thread::yield();
+  }
+  return iterations;
+}
+}// namespace
+
+TEST_CASE("ThreadPool cancellable task can be stopped while running", "[ThreadPool][Cancellation]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{1, mode};
+  std::atomic<bool> started = false;
+  auto future = pool.enqueue([&](std::stop_token token) {
+    started = true;
+    return runUntilStopped(token);
+  });
+  while (!started) { std::this_thread::yield(); }
+  REQUIRE(future.requestStop());
+  REQUIRE(future.isStopRequested());
+  REQUIRE(future.get() >= 0);
+}
+
+TEST_CASE("ThreadPool cancellable task is not run when cancelled before start", "[ThreadPool][Cancellation]") {
+  ThreadPool pool{1};
+  std::atomic<bool> blocked = true;
+  pool.post([&] {
+    while (blocked) { std::this_thread::yield(); }
+  });
+  std::atomic<bool> ran = false;
+  auto future = pool.enqueue([&](std::stop_token) { ran = true; });
+  future.requestStop();
+  blocked = false;
+  REQUIRE_THROWS_AS(future.get(), TaskCancelled);
+  REQUIRE_FALSE(ran);
+}
+
+TEST_CASE("ThreadPool group cancellation stops all tasks of the group", "[ThreadPool][Cancellation]") {
+  ThreadPool pool{4};
+  auto group = std::stop_source{};
+  std::atomic<int> started = 0;
+  auto futures = std::vector<CancellableFuture<int>>{};
+  for (int i = 0; i < 3; ++i) {
+    futures.emplace_back(pool.enqueue(group.get_token(), [&](std::stop_token token) {
+      ++started;
+      return runUntilStopped(token);
+    }));
+  }
+  // not part of the group, keeps running
+  auto other = pool.enqueue([](std::stop_token token) { return runUntilStopped(token); });
+  while (started != 3) { std::this_thread::yield(); }
+  group.request_stop();
+  for (auto &future : futures) { REQUIRE(future.get() >= 0); }
+  REQUIRE(other.wait_for(std::chrono::milliseconds{10}) == std::future_status::timeout);
+  other.requestStop();
+  other.wait();
+}
+
+TEST_CASE("ThreadPool post with group token", "[ThreadPool][Cancellation]") {
+  auto group = std::stop_source{};
+  std::atomic<int> started = 0;
+  std::atomic<int> stopped = 0;
+  {
+    ThreadPool pool{2};
+    for (int i = 0; i < 2; ++i) {
+      pool.post(group.get_token(), [&](std::stop_token token) {
+        ++started;
+        runUntilStopped(token);
+        ++stopped;
+      });
+    }
+    while (started != 2) { std::this_thread::yield(); }
+    group.request_stop();
+    // cancelled before start, must not be run
+    pool.post(group.get_token(), [&](std::stop_token) { ++stopped; });
+  }
+  REQUIRE(stopped == 2);
+}
+
+TEST_CASE("ThreadPool cancelAndStop stops running cancellable tasks", "[ThreadPool][Cancellation]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{1, mode};
+  std::atomic<bool> started = false;
+  auto future = pool.enqueue([&](std::stop_token token) {
+    started = true;
+    return runUntilStopped(token);
+  });
+  while (!started) { std::this_thread::yield(); }
+  pool.cancelAndStop();
+  REQUIRE(future.get() >= 0);
+}
+
+TEST_CASE("ThreadPool submits generic callables as cancellable tasks", "[ThreadPool][Cancellation]") {
+  ThreadPool pool{1};
+  // the task receives the stop token
+  REQUIRE(pool.enqueue([](auto &&...args) { return sizeof...(args); }).get() == 1);
+  REQUIRE(pool.enqueue([] { return 1; }).get() == 1);
+}
@@ -0,0 +1,55 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <pf_common/parallel/CpuTopology.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("parseCpuList parses kernel cpu lists", "[CpuTopology]") {
+  REQUIRE(details::parseCpuList("0") == std::vector<std::size_t>{0});
+  REQUIRE(details::parseCpuList("0-3,8,10-11\n") == std::vector<std::size_t>{0, 1, 2, 3, 8, 10, 11});
+  REQUIRE(details::parseCpuList("") == std::vector<std::size_t>{});
+  REQUIRE_FALSE(details::parseCpuList("3-1").has_value());
+  REQUIRE_FALSE(details::parseCpuList("a-b").has_value());
+}
+
+TEST_CASE("readNumaTopology returns at least one node with cpus", "[CpuTopology]") {
+  const auto nodes = readNumaTopology();
+  REQUIRE_FALSE(nodes.empty());
+  for (const auto &node : nodes) { REQUIRE_FALSE(node.cpus.empty()); }
+}
+
+TEST_CASE("ThreadPool with worker placement runs tasks", "[CpuTopology][ThreadPool]") {
+  const auto pinToCores = GENERATE(false, true);
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool{4, ThreadPoolMode::WorkStealing, WorkerPlacement{.pinToCores = pinToCores, .groupByNumaNode = true}};
+    REQUIRE_FALSE(pool.getNumaNodes().empty());
+    for (std::size_t i = 0; i < pool.getThreadCount(); ++i) { REQUIRE(pool.getWorkerNode(i) < pool.getNumaNodes().size()); }
+    for (int i = 0; i < 100; ++i) {
+      pool.postOnNode(static_cast<std::size_t>(i) % pool.getNumaNodes().size(), [&] { ++counter; });
+    }
+    REQUIRE(pool.enqueueOnNode(0, [&] {
+                  pool.postOnNode(0, [&] { ++counter; });
+                  return 1;
+                })
+                .get()
+            == 1);
+  }
+  REQUIRE(counter == 101);
+}
+
+#ifdef __linux__
+TEST_CASE("ThreadPool pins workers to cores", "[CpuTopology][ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  const auto nodes = readNumaTopology();
+  ThreadPool pool{1, mode, WorkerPlacement{.pinToCores = true}};
+  const auto cpu = pool.enqueue([] { return sched_getcpu(); }).get();
+  REQUIRE(cpu == static_cast<int>(nodes.front().cpus.front()));
+}
+#endif
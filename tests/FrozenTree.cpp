@@ -0,0 +1,86 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <pf_common/containers/FrozenTree.h>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include "TreeTestUtils.h"
+
+using namespace pf;
+
+TEST_CASE("FrozenTree layout and traversal", "[FrozenTree]") {
+  const auto tree = makeTree<Tree<int>>();
+  const auto frozen = freeze(tree);
+  REQUIRE(frozen.size() == 7);
+  REQUIRE(collect(frozen.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+  REQUIRE(collect(frozen.iterBreadthFirst()) == std::vector{0, 1, 2, 3, 4, 5, 6});
+
+  SECTION("subtrees") {
+    REQUIRE(frozen.subtreeSize(0) == 7);
+    REQUIRE(frozen.subtreeSize(1) == 3);
+    REQUIRE(frozen.subtreeEnd(1) == 4);
+    REQUIRE(frozen[frozen.subtreeEnd(1)] == 2);
+    REQUIRE(collect(frozen.iterDepthFirst(5)) == std::vector{3, 6});
+    REQUIRE(frozen.isLeaf(2));
+    REQUIRE_FALSE(frozen.isLeaf(5));
+  }
+  SECTION("children and parents") {
+    REQUIRE(collect(frozen.children(0) | std::views::transform([&](auto index) { return frozen[index]; })) == std::vector{1, 2, 3});
+    REQUIRE(frozen.childrenSize(1) == 2);
+    REQUIRE(frozen.childrenSize(4) == 0);
+    REQUIRE(frozen.parent(0) == FrozenTree<int>::NO_PARENT);
+    REQUIRE(frozen.parent(6) == 5);
+  }
+  SECTION("levels") {
+    REQUIRE(frozen.levelCount() == 3);
+    REQUIRE(collect(frozen.level(0) | std::views::transform([&](auto index) { return frozen[index]; })) == std::vector{0});
+    REQUIRE(collect(frozen.level(1) | std::views::transform([&](auto index) { return frozen[index]; })) == std::vector{1, 2, 3});
+    REQUIRE(collect(frozen.level(2) | std::views::transform([&](auto index) { return frozen[index]; })) == std::vector{4, 5, 6});
+  }
+  SECTION("skipping subtrees") {
+    auto visited = std::vector<int>{};
+    for (FrozenTree<int>::index_type i = 0; i < frozen.size();) {
+      visited.emplace_back(frozen[i]);
+      i = frozen[i] == 1 ? frozen.subtreeEnd(i) : i + 1;
+    }
+    REQUIRE(visited == std::vector{0, 1, 2, 3, 6});
+  }
+}
+
+TEST_CASE("FrozenTree from ArenaTree matches Tree", "[FrozenTree]") {
+  const auto fromTree = freeze(makeTree<Tree<int>>());
+  const auto fromArena = freeze(makeTree<ArenaTree<int>>());
+  REQUIRE(collect(fromArena.iterDepthFirst()) == collect(fromTree.iterDepthFirst()));
+  REQUIRE(collect(fromArena.iterBreadthFirst()) == collect(fromTree.iterBreadthFirst()));
+}
+
+TEST_CASE("FrozenTree moves values out of an rvalue tree", "[FrozenTree]") {
+  auto tree = Tree<std::unique_ptr<int>>{std::make_unique<int>(1)};
+  tree.getRoot().appendChild(std::make_unique<int>(2));
+  const auto frozen = freeze(std::move(tree));
+  REQUIRE(frozen.size() == 2);
+  REQUIRE(*frozen[1] == 2);
+
+  const auto strings = freeze(Tree<std::string>{std::string{"root"}});
+  REQUIRE(strings[0] == "root");
+}
+
+TEST_CASE("FrozenTree of an empty tree and a deep tree", "[FrozenTree]") {
+  const auto empty = freeze(Tree<int>{});
+  REQUIRE(empty.empty());
+  REQUIRE(empty.iterDepthFirst().empty());
+  REQUIRE(empty.levelCount() == 0);
+
+  auto deep = ArenaTree<int>{0};
+  auto *node = &deep.getRoot();
+  for (int i = 1; i < 100'000; ++i) { node = &node->appendChild(i); }
+  const auto frozen = freeze(deep);
+  REQUIRE(frozen.levelCount() == 100'000);
+  REQUIRE(frozen.subtreeSize(0) == 100'000);
+  REQUIRE(frozen.subtreeSize(99'999) == 1);
+}
@@ -0,0 +1,87 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <pf_common/allocators/PoolAllocator.h>
+#include <pf_common/parallel/InplaceTask.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("InplaceTask stores small callables inline", "[InplaceTask]") {
+  int value = 0;
+  auto small = [&value] { ++value; };
+  auto big = [&value, data = std::array<char, 128>{}] { value += data.size(); };
+  STATIC_REQUIRE(InplaceTask<>::isStoredInline<decltype(small)>);
+  STATIC_REQUIRE_FALSE(InplaceTask<>::isStoredInline<decltype(big)>);
+
+  InplaceTask<> smallTask{small};
+  InplaceTask<> bigTask{big};
+  smallTask();
+  bigTask();
+  REQUIRE(value == 129);
+}
+
+TEST_CASE("InplaceTask move transfers the callable", "[InplaceTask]") {
+  auto counter = std::make_shared<int>(0);
+  InplaceTask<> task{[ptr = std::make_unique<int>(1), counter] { *counter += *ptr; }};
+  REQUIRE(counter.use_count() == 2);
+
+  InplaceTask<> moved{std::move(task)};
+  REQUIRE_FALSE(task);
+  REQUIRE(moved);
+  moved();
+  REQUIRE(*counter == 1);
+
+  task = std::move(moved);
+  task();
+  REQUIRE(*counter == 2);
+  task.reset();
+  REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("PoolAllocator recycles blocks", "[PoolAllocator]") {
+  auto allocator = PoolAllocator<std::array<int, 8>>{};
+  auto first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  auto second = allocator.allocate(1);
+  REQUIRE(first == second);
+  allocator.deallocate(second, 1);
+}
+
+TEST_CASE("PoolAllocator blocks can be freed on another thread", "[PoolAllocator]") {
+  auto allocator = PoolAllocator<std::array<int, 8>>{};
+  auto blocks = std::vector<std::array<int, 8> *>{};
+  for (int i = 0; i < 1000; ++i) { blocks.emplace_back(allocator.allocate(1)); }
+  std::thread{[&] {
+    for (auto block : blocks) { allocator.deallocate(block, 1); }
+  }}.join();
+  for (auto &block : blocks) { block = allocator.allocate(1); }
+  for (auto block : blocks) { allocator.deallocate(block, 1); }
+}
+
+namespace {
+using LateBlock = std::array<int, 5>;
+// destroyed after the allocator's thread cache when constructed before the first allocation on its thread
+struct LateDeallocation {
+  ~LateDeallocation() {
+    auto allocator = PoolAllocator<LateBlock>{};
+    allocator.deallocate(block, 1);
+    allocator.deallocate(allocator.allocate(1), 1);
+  }
+  LateBlock *block = nullptr;
+};
+}// namespace
+
+TEST_CASE("PoolAllocator can be used after thread's cache was destroyed", "[PoolAllocator]") {
+  std::thread{[] {
+    thread_local LateDeallocation late{};
+    late.block = PoolAllocator<LateBlock>{}.allocate(1);
+  }}.join();
+  auto allocator = PoolAllocator<LateBlock>{};
+  allocator.deallocate(allocator.allocate(1), 1);
+}
@@ -0,0 +1,74 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <pf_common/parallel/MPMCQueue.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("MPMCQueue capacity is rounded to power of 2", "[MPMCQueue]") {
+  const MPMCQueue<int> queue{100};
+  REQUIRE(queue.capacity() == 128);
+  REQUIRE(queue.isEmpty());
+}
+
+TEST_CASE("MPMCQueue single thread FIFO", "[MPMCQueue]") {
+  MPMCQueue<std::unique_ptr<int>> queue{4};
+  for (int i = 0; i < 4; ++i) { REQUIRE(queue.tryEnqueue(std::make_unique<int>(i))); }
+  REQUIRE(queue.size() == 4);
+
+  SECTION("try enqueue fails when full and keeps the item") {
+    auto item = std::make_unique<int>(10);
+    REQUIRE_FALSE(queue.tryEnqueue(std::move(item)));
+    REQUIRE(item != nullptr);
+  }
+  SECTION("items are dequeued in order") {
+    for (int i = 0; i < 4; ++i) { REQUIRE(*queue.dequeue().value() == i); }
+    REQUIRE_FALSE(queue.tryDequeue().has_value());
+  }
+}
+
+TEST_CASE("MPMCQueue timed operations", "[MPMCQueue]") {
+  MPMCQueue<int> queue{2};
+  REQUIRE_FALSE(queue.dequeueFor(std::chrono::milliseconds{1}).has_value());
+  REQUIRE(queue.enqueueFor(1, std::chrono::milliseconds{1}));
+  REQUIRE(queue.enqueueFor(2, std::chrono::milliseconds{1}));
+  REQUIRE_FALSE(queue.enqueueFor(3, std::chrono::milliseconds{1}));
+  REQUIRE(queue.dequeueFor(std::chrono::milliseconds{1}) == 1);
+}
+
+TEST_CASE("MPMCQueue shutdown wakes up consumers", "[MPMCQueue]") {
+  MPMCQueue<int> queue{};
+  auto consumer = std::thread{[&] { REQUIRE_FALSE(queue.dequeue().has_value()); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  queue.shutdown();
+  consumer.join();
+}
+
+TEST_CASE("MPMCQueue multiple producers and consumers", "[MPMCQueue]") {
+  constexpr static int PER_PRODUCER = 10000;
+  constexpr static int THREAD_COUNT = 4;
+  MPMCQueue<int> queue{64};
+  auto results = std::vector<std::vector<int>>(THREAD_COUNT);
+  auto threads = std::vector<std::thread>{};
+  for (int i = 0; i < THREAD_COUNT; ++i) {
+    threads.emplace_back([&queue, i] {
+      for (int j = 0; j < PER_PRODUCER; ++j) { queue.enqueue(i * PER_PRODUCER + j); }
+    });
+    threads.emplace_back([&queue, &results, i] {
+      for (int j = 0; j < PER_PRODUCER; ++j) { results[i].emplace_back(queue.dequeue().value()); }
+    });
+  }
+  for (auto &thread : threads) { thread.join(); }
+
+  auto all = std::vector<int>{};
+  for (const auto &result : results) { all.insert(all.end(), result.begin(), result.end()); }
+  std::ranges::sort(all);
+  REQUIRE(all.size() == PER_PRODUCER * THREAD_COUNT);
+  for (int i = 0; i < PER_PRODUCER * THREAD_COUNT; ++i) { REQUIRE(all[i] == i); }
+}
@@ -0,0 +1,161 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <pf_common/ObjectPool.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("ObjectPool recycles released objects", "[ObjectPool]") {
+  ObjectPool<std::string, 4> pool{[] { return std::string{"initial"}; }};
+  REQUIRE(pool.capacity() == 4);
+  REQUIRE(pool.available() == 4);
+  std::string *leasedAddress = nullptr;
+  {
+    auto handle = pool.lease();
+    REQUIRE(*handle == "initial");
+    *handle = "changed";
+    leasedAddress = handle.get();
+    REQUIRE(pool.used() == 1);
+  }
+  REQUIRE(pool.used() == 0);
+  auto handle = pool.lease();
+  REQUIRE(handle.get() == leasedAddress);
+  REQUIRE(*handle == "changed");
+}
+
+TEST_CASE("ObjectPool handle ownership", "[ObjectPool]") {
+  ObjectPool<int, 2> pool{};
+  auto handle = pool.lease();
+  auto moved = std::move(handle);
+  REQUIRE_FALSE(handle);
+  REQUIRE(moved);
+  REQUIRE(pool.used() == 1);
+  handle = pool.lease();
+  REQUIRE(pool.used() == 2);
+  handle = std::move(moved);
+  REQUIRE(pool.used() == 1);
+  handle.reset();
+  REQUIRE_FALSE(handle);
+  REQUIRE(pool.used() == 0);
+}
+
+TEST_CASE("ObjectPool runs out of objects", "[ObjectPool]") {
+  ObjectPool<int, 2, PoolAllocStrategy::OnDemand> pool{};
+  auto first = pool.lease();
+  auto second = pool.lease();
+  REQUIRE_FALSE(pool.tryLease());
+  REQUIRE_THROWS_AS(pool.lease(), std::runtime_error);
+  second.reset();
+  REQUIRE(pool.tryLease());
+}
+
+TEST_CASE("ObjectPool growth strategies", "[ObjectPool]") {
+  SECTION("preallocate") {
+    std::size_t generated = 0;
+    ObjectPool<int, 8> pool{[&] { return static_cast<int>(generated++); }};
+    REQUIRE(generated == 8);
+    REQUIRE(pool.capacity() == 8);
+  }
+  SECTION("increase by 2x") {
+    ObjectPool<int, 6, PoolAllocStrategy::IncreaseBy2x> pool{};
+    REQUIRE(pool.capacity() == 0);
+    auto handles = std::vector<ObjectPool<int, 6, PoolAllocStrategy::IncreaseBy2x>::Handle>{};
+    auto capacities = std::vector<std::size_t>{};
+    for (int i = 0; i < 6; ++i) {
+      handles.emplace_back(pool.lease());
+      capacities.emplace_back(pool.capacity());
+    }
+    REQUIRE(capacities == std::vector<std::size_t>{1, 2, 4, 4, 6, 6});
+  }
+  SECTION("on demand") {
+    ObjectPool<int, 3, PoolAllocStrategy::OnDemand> pool{};
+    auto first = pool.lease();
+    auto second = pool.lease();
+    REQUIRE(pool.capacity() == 2);
+    first.reset();
+    first = pool.lease();
+    REQUIRE(pool.capacity() == 2);
+  }
+}
+
+TEST_CASE("ObjectPool with thread caches never leases an object twice", "[ObjectPool]") {
+  constexpr static std::size_t THREAD_COUNT = 4;
+  constexpr static std::size_t ITERATION_COUNT = 20'000;
+  ObjectPool<std::atomic<int>, 4096, PoolAllocStrategy::IncreaseBy2x, true> pool{};
+  std::atomic<bool> doubleLease = false;
+  auto threads = std::vector<std::jthread>{};
+  for (std::size_t i = 0; i < THREAD_COUNT; ++i) {
+    threads.emplace_back([&] {
+      auto handles = std::vector<decltype(pool)::Handle>{};
+      for (std::size_t j = 0; j < ITERATION_COUNT; ++j) {
+        auto handle = pool.lease();
+        if (handle->fetch_add(1) != 0) { doubleLease = true; }
+        handles.emplace_back(std::move(handle));
+        // keep some objects leased so they are released in batches
+        if (handles.size() == 50) {
+          for (auto &leased : handles) { leased->fetch_sub(1); }
+          handles.clear();
+        }
+      }
+      for (auto &leased : handles) { leased->fetch_sub(1); }
+    });
+  }
+  threads.clear();
+  REQUIRE_FALSE(doubleLease);
+  // caches of the finished threads were returned to the pool
+  REQUIRE(pool.used() == 0);
+}
+
+TEST_CASE("ObjectPool thread cache of a destroyed pool is dropped", "[ObjectPool]") {
+  using Pool = ObjectPool<int, 64, PoolAllocStrategy::OnDemand, true>;
+  for (int i = 0; i < 3; ++i) {
+    Pool pool{};
+    auto handle = pool.lease();
+    *handle = i;
+    handle.reset();
+    REQUIRE(pool.used() == 1);
+    REQUIRE(*pool.lease() == i);
+  }
+}
+
+TEST_CASE("ObjectPool handle released after thread's caches were destroyed", "[ObjectPool]") {
+  using Pool = ObjectPool<int, 64, PoolAllocStrategy::Preallocate, true>;
+  Pool pool{};
+  std::thread{[&] {
+    // created before the thread's caches, so it's destroyed after them
+    thread_local auto lateHandle = Pool::Handle{};
+    lateHandle = pool.lease();
+  }}.join();
+  REQUIRE(pool.used() == 0);
+}
+
+TEST_CASE("ObjectPool creates objects outside of the lock", "[ObjectPool]") {
+  std::atomic<int> generatedCount = 0;
+  std::atomic<bool> generatorBlocked = false;
+  std::atomic<bool> released = false;
+  ObjectPool<int, 2, PoolAllocStrategy::OnDemand> pool{[&] {
+    if (generatedCount++ == 1) {
+      generatorBlocked = true;
+      while (!released) { std::this_thread::yield(); }
+    }
+    return 0;
+  }};
+  auto first = pool.lease();
+  auto grower = std::thread{[&] { auto second = pool.lease(); }};
+  while (!generatorBlocked) { std::this_thread::yield(); }
+  // would spin forever if the growing thread held the pool's lock while running the generator
+  first.reset();
+  REQUIRE(pool.available() == 1);
+  released = true;
+  grower.join();
+  REQUIRE(pool.capacity() == 2);
+}
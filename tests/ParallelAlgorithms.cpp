@@ -0,0 +1,119 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstddef>
+#include <numeric>
+#include <pf_common/containers/SmallVector.h>
+#include <pf_common/containers/StaticVector.h>
+#include <pf_common/parallel/algorithms.h>
+#include <pf_common/views/View2D.h>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace pf;
+
+namespace {
+/**
+ * Accumulator which can't be created from an element.
+ */
+struct ElementCounter {
+  ElementCounter() = default;
+  std::size_t count = 0;
+};
+struct CountElements {
+  ElementCounter operator()(ElementCounter counter, int) const {
+    ++counter.count;
+    return counter;
+  }
+  ElementCounter operator()(ElementCounter lhs, ElementCounter rhs) const {
+    lhs.count += rhs.count;
+    return lhs;
+  }
+};
+
+template<typename T, typename BinaryOp>
+concept ReducibleInts = requires(ThreadPool &pool, std::vector<int> &data, T init, BinaryOp op) { parallelReduce(pool, data, init, op); };
+}// namespace
+
+TEST_CASE("parallelFor visits every element once", "[parallel][parallelFor]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{4, mode};
+
+  SECTION("std::vector") {
+    auto data = std::vector<int>(10000, 1);
+    parallelFor(pool, data, [](int &value) { value *= 3; });
+    REQUIRE(std::ranges::all_of(data, [](int value) { return value == 3; }));
+  }
+  SECTION("SmallVector and StaticVector") {
+    auto small = SmallVector<int, 16>{};
+    for (int i = 0; i < 1000; ++i) { small.push_back(1); }
+    auto fixed = StaticVector<int, 64>(60, 1);
+    parallelFor(pool, small, [](int &value) { ++value; });
+    parallelFor(pool, fixed, [](int &value) { ++value; }, 1);
+    REQUIRE(std::ranges::all_of(small, [](int value) { return value == 2; }));
+    REQUIRE(std::ranges::all_of(fixed, [](int value) { return value == 2; }));
+  }
+  SECTION("View2D rows") {
+    auto data = std::vector<int>(32 * 32, 0);
+    auto view = makeView2D(data, 32);
+    parallelFor(pool, std::views::iota(std::size_t{0}, view.size()), [&](std::size_t row) {
+      for (std::size_t column = 0; column < view.getWidth(); ++column) { view[column][row] = static_cast<int>(row); }
+    });
+    for (std::size_t i = 0; i < data.size(); ++i) { REQUIRE(data[i] == static_cast<int>(i / 32)); }
+  }
+}
+
+TEST_CASE("parallelFor can be nested in pool's tasks", "[parallel][parallelFor]") {
+  ThreadPool pool{2, ThreadPoolMode::WorkStealing};
+  auto data = std::vector<int>(1000, 0);
+  pool.enqueue([&] {
+        parallelFor(pool, std::views::iota(0, 10), [&](int i) {
+          parallelFor(pool, std::span{data}.subspan(i * 100, 100), [](int &value) { ++value; });
+        });
+      })
+      .get();
+  REQUIRE(std::ranges::all_of(data, [](int value) { return value == 1; }));
+}
+
+TEST_CASE("parallelFor rethrows exceptions", "[parallel][parallelFor]") {
+  ThreadPool pool{4};
+  REQUIRE_THROWS_AS(parallelFor(pool, std::views::iota(0, 1000),
+                                [](int i) {
+                                  if (i == 500) { throw std::runtime_error("error"); }
+                                }),
+                    std::runtime_error);
+}
+
+TEST_CASE("parallelReduce", "[parallel][parallelReduce]") {
+  ThreadPool pool{4};
+  auto data = std::vector<int>(10001);
+  std::iota(data.begin(), data.end(), 0);
+  REQUIRE(parallelReduce(pool, data, 0LL) == 50005000LL);
+  REQUIRE(parallelReduce(pool, std::vector<int>{}, 5) == 5);
+
+  SECTION("keeps order for non commutative operations") {
+    auto letters = std::vector<std::string>{};
+    for (char c = 'a'; c <= 'z'; ++c) { letters.emplace_back(1, c); }
+    REQUIRE(parallelReduce(pool, letters, std::string{">"}, std::plus<>{}, 3) == ">abcdefghijklmnopqrstuvwxyz");
+  }
+
+  SECTION("requires accumulator constructible from an element") {
+    REQUIRE(ReducibleInts<long long, std::plus<>>);
+    REQUIRE(!ReducibleInts<ElementCounter, CountElements>);
+  }
+}
+
+TEST_CASE("parallelTransform", "[parallel][parallelTransform]") {
+  ThreadPool pool{4};
+  auto input = std::vector<int>(5000);
+  std::iota(input.begin(), input.end(), 0);
+  auto output = std::vector<long long>(input.size());
+  const auto end = parallelTransform(pool, input, output, [](int value) { return static_cast<long long>(value) * value; });
+  REQUIRE(end == output.end());
+  for (std::size_t i = 0; i < input.size(); ++i) { REQUIRE(output[i] == static_cast<long long>(i * i)); }
+}
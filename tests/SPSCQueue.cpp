@@ -0,0 +1,62 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <pf_common/parallel/SPSCQueue.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("SPSCQueue single thread", "[SPSCQueue]") {
+  SPSCQueue<std::string> queue{3};
+  REQUIRE(queue.capacity() == 4);
+  for (int i = 0; i < 4; ++i) { REQUIRE(queue.tryEnqueue(std::to_string(i))); }
+  auto item = std::string{"full"};
+  REQUIRE_FALSE(queue.tryEnqueue(std::move(item)));
+  REQUIRE(item == "full");
+  REQUIRE(queue.size() == 4);
+  for (int i = 0; i < 4; ++i) { REQUIRE(queue.tryDequeue() == std::to_string(i)); }
+  REQUIRE_FALSE(queue.tryDequeue().has_value());
+  REQUIRE(queue.isEmpty());
+}
+
+TEST_CASE("SPSCQueue batch operations wrap around", "[SPSCQueue]") {
+  SPSCQueue<int> queue{8};
+  auto input = std::array<int, 6>{};
+  std::iota(input.begin(), input.end(), 0);
+  auto output = std::array<int, 6>{};
+
+  REQUIRE(queue.tryEnqueueBatch(input) == 6);
+  REQUIRE(queue.tryDequeueBatch(std::span{output}.first(4)) == 4);
+  REQUIRE(queue.tryEnqueueBatch(input) == 6);
+  REQUIRE(queue.tryEnqueueBatch(input) == 0);
+  REQUIRE(queue.tryDequeueBatch(output) == 6);
+  REQUIRE(output == std::array{4, 5, 0, 1, 2, 3});
+  REQUIRE(queue.tryDequeueBatch(output) == 2);
+  REQUIRE(output[0] == 4);
+  REQUIRE(output[1] == 5);
+}
+
+TEST_CASE("SPSCQueue shutdown stops blocking dequeue", "[SPSCQueue]") {
+  SPSCQueue<int> queue{};
+  auto consumer = std::thread{[&] { REQUIRE_FALSE(queue.dequeue().has_value()); }};
+  queue.shutdown();
+  consumer.join();
+}
+
+TEST_CASE("SPSCQueue producer and consumer threads", "[SPSCQueue]") {
+  constexpr static int ITEM_COUNT = 100000;
+  SPSCQueue<int> queue{64};
+  auto producer = std::thread{[&] {
+    for (int i = 0; i < ITEM_COUNT; ++i) { queue.enqueue(int{i}); }
+  }};
+  auto received = std::vector<int>{};
+  for (int i = 0; i < ITEM_COUNT; ++i) { received.emplace_back(queue.dequeue().value()); }
+  producer.join();
+  for (int i = 0; i < ITEM_COUNT; ++i) { REQUIRE(received[i] == i); }
+}
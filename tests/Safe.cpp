@@ -0,0 +1,61 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <pf_common/parallel/Safe.h>
+#include <pf_common/parallel/SeqLock.h>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("Safe read write access", "[Safe]") {
+  Safe<std::string> safe{"abc"};
+  safe->append("def");
+  REQUIRE(*safe.readOnlyAccess() == "abcdef");
+}
+
+TEST_CASE("Safe with shared_mutex allows concurrent readers", "[Safe]") {
+  const Safe<int, std::shared_mutex> safe{10};
+  auto first = safe.readOnlyAccess();
+  std::thread{[&] {
+    // would deadlock with exclusive locking
+    auto second = safe.readOnlyAccess();
+    REQUIRE(*second == 10);
+  }}.join();
+  REQUIRE(*first == 10);
+}
+
+TEST_CASE("SeqLock is detected as sequence lock", "[Safe][SeqLock]") {
+  // Safe rejects sequence locks protecting data which can't be copied by readers
+  REQUIRE(SequenceLock<SeqLock>);
+  REQUIRE_FALSE(SequenceLock<std::shared_mutex>);
+  REQUIRE_FALSE(SequenceLockable<SeqLock, std::string>);
+}
+
+TEST_CASE("Safe with SeqLock reads consistent copies", "[Safe][SeqLock]") {
+  struct Pair {
+    long first;
+    long second;
+  };
+  Safe<Pair, SeqLock> safe{Pair{0, 0}};
+  std::atomic<bool> stop = false;
+  auto writer = std::thread{[&] {
+    for (long i = 1; i < 10000; ++i) {
+      auto access = safe.writeAccess();
+      access->first = i;
+      access->second = -i;
+    }
+    stop = true;
+  }};
+  while (!stop) {
+    const auto access = safe.readOnlyAccess();
+    REQUIRE(access->first == -access->second);
+  }
+  writer.join();
+  REQUIRE(safe.readOnlyAccess()->first == 9999);
+}
@@ -0,0 +1,164 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <array>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <numeric>
+#include <pf_common/parallel/SafeQueue.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("SafeQueue enqueueRange keeps order", "[SafeQueue]") {
+  SafeQueue<int> queue;
+  queue.enqueueRange(std::vector{1, 2, 3, 4});
+  REQUIRE(queue.size() == 4);
+  for (auto i = 1; i <= 4; ++i) { REQUIRE(queue.dequeue() == i); }
+}
+
+TEST_CASE("SafeQueue dequeueBatch moves up to span size", "[SafeQueue]") {
+  SafeQueue<int> queue;
+  queue.enqueueRange(std::vector{1, 2, 3, 4, 5});
+  auto out = std::array<int, 3>{};
+  REQUIRE(queue.dequeueBatch(out) == 3);
+  REQUIRE(out == std::array{1, 2, 3});
+  REQUIRE(queue.dequeueBatch(out) == 2);
+  REQUIRE(out[0] == 4);
+  REQUIRE(out[1] == 5);
+  REQUIRE(queue.isEmpty());
+}
+
+TEST_CASE("SafeQueue dequeueBatch waits for items and returns 0 after shutdown", "[SafeQueue]") {
+  SafeQueue<int> queue;
+  auto out = std::array<int, 4>{};
+  auto consumer = std::thread{[&] { REQUIRE(queue.dequeueBatch(out) >= 1); }};
+  queue.enqueue(10);
+  consumer.join();
+  REQUIRE(out[0] == 10);
+
+  queue.shutdown();
+  REQUIRE(queue.dequeueBatch(out) == 0);
+}
+
+TEST_CASE("SafeQueue drainInto doesn't wait and respects maxCount", "[SafeQueue]") {
+  SafeQueue<int> queue;
+  auto result = std::vector<int>{};
+  REQUIRE(queue.drainInto(result) == 0);
+  queue.enqueueRange(std::vector{1, 2, 3, 4, 5});
+  REQUIRE(queue.drainInto(result, 2) == 2);
+  REQUIRE(result == std::vector{1, 2});
+  REQUIRE(queue.drainInto(result) == 3);
+  REQUIRE(result == std::vector{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("SafeQueue batches between threads", "[SafeQueue]") {
+  constexpr auto COUNT = 10'000;
+  SafeQueue<int> queue;
+  auto producer = std::thread{[&] {
+    auto batch = std::vector<int>(100);
+    for (auto i = 0; i < COUNT; i += 100) {
+      std::iota(batch.begin(), batch.end(), i);
+      queue.enqueueRange(batch);
+    }
+  }};
+  auto received = std::vector<int>{};
+  auto buffer = std::array<int, 64>{};
+  while (received.size() < COUNT) {
+    const auto count = queue.dequeueBatch(buffer);
+    received.insert(received.end(), buffer.begin(), buffer.begin() + count);
+  }
+  producer.join();
+  auto expected = std::vector<int>(COUNT);
+  std::iota(expected.begin(), expected.end(), 0);
+  REQUIRE(received == expected);
+}
+
+TEST_CASE("SafeQueue tryDequeue doesn't wait", "[SafeQueue]") {
+  SafeQueue<int> queue;
+  REQUIRE_FALSE(queue.tryDequeue().has_value());
+  queue.enqueue(1);
+  REQUIRE(queue.tryDequeue() == 1);
+  REQUIRE_FALSE(queue.tryDequeue().has_value());
+  queue.enqueue(2);
+  queue.shutdown();
+  REQUIRE_FALSE(queue.tryDequeue().has_value());
+}
+
+TEST_CASE("SafeQueue dequeueFor times out", "[SafeQueue]") {
+  using namespace std::chrono_literals;
+  SafeQueue<int> queue;
+  const auto start = std::chrono::steady_clock::now();
+  REQUIRE_FALSE(queue.dequeueFor(20ms).has_value());
+  REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+  queue.enqueue(3);
+  REQUIRE(queue.dequeueFor(20ms) == 3);
+}
+
+TEST_CASE("SafeQueue dequeueUntil receives item from another thread", "[SafeQueue]") {
+  using namespace std::chrono_literals;
+  SafeQueue<int> queue;
+  auto producer = std::thread{[&] {
+    std::this_thread::sleep_for(5ms);
+    queue.enqueue(4);
+  }};
+  REQUIRE(queue.dequeueUntil(std::chrono::steady_clock::now() + 10s) == 4);
+  producer.join();
+}
+
+TEST_CASE("SafeQueue dequeueFor is woken by shutdown", "[SafeQueue]") {
+  using namespace std::chrono_literals;
+  SafeQueue<int> queue;
+  auto consumer = std::thread{[&] { REQUIRE_FALSE(queue.dequeueFor(10s).has_value()); }};
+  std::this_thread::sleep_for(5ms);
+  queue.shutdown();
+  consumer.join();
+}
+
+TEST_CASE("SafeQueue with spinning passes items between threads", "[SafeQueue]") {
+  constexpr auto COUNT = 10'000;
+  SafeQueue<int> queue;
+  queue.setSpinCount(1000);
+  REQUIRE(queue.getSpinCount() == 1000);
+  auto producer = std::thread{[&] {
+    for (auto i = 0; i < COUNT; ++i) { queue.enqueue(int{i}); }
+  }};
+  auto sum = 0ll;
+  for (auto i = 0; i < COUNT; ++i) { sum += queue.dequeue().value(); }
+  producer.join();
+  REQUIRE(sum == COUNT * (COUNT - 1ll) / 2);
+}
+
+TEST_CASE("SafeQueue wakes a waiting consumer for every item", "[SafeQueue]") {
+  // both consumers wait and two items come right after each other, notifying only when the queue was empty wakes just one of them
+  // and the other item stays in the queue - timing dependent, so the scenario is repeated
+  using namespace std::chrono_literals;
+  for (int round = 0; round < 200; ++round) {
+    SafeQueue<int> queue;
+    std::atomic<int> startedCount = 0;
+    std::atomic<int> dequeuedCount = 0;
+    const auto consume = [&] {
+      ++startedCount;
+      if (!queue.dequeue().has_value()) { return; }
+      ++dequeuedCount;
+      const auto deadline = std::chrono::steady_clock::now() + 1s;
+      while (dequeuedCount < 2 && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+    };
+    auto first = std::thread{consume};
+    auto second = std::thread{consume};
+    while (startedCount < 2) { std::this_thread::yield(); }
+    std::this_thread::sleep_for(2ms);
+    queue.enqueue(1);
+    queue.enqueue(2);
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (dequeuedCount < 2 && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+    const auto dequeuedInTime = dequeuedCount.load();
+    queue.shutdown();
+    first.join();
+    second.join();
+    REQUIRE(dequeuedInTime == 2);
+  }
+}
@@ -0,0 +1,48 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <pf_common/parallel/Snapshot.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("Snapshot keeps old versions alive for readers", "[Snapshot]") {
+  Snapshot<std::string> snapshot{"first"};
+  const auto old = snapshot.load();
+  snapshot.store("second");
+  REQUIRE(*old == "first");
+  REQUIRE(*snapshot.load() == "second");
+
+  std::weak_ptr<const std::string> weakOld = old;
+  REQUIRE_FALSE(weakOld.expired());
+}
+
+TEST_CASE("Snapshot reader sees published versions", "[Snapshot]") {
+  Snapshot<std::map<int, int>> snapshot{};
+  auto reader = snapshot.reader();
+  REQUIRE(reader->empty());
+  snapshot.update([](auto &map) { map[1] = 10; });
+  REQUIRE(reader->at(1) == 10);
+  REQUIRE(snapshot.load()->size() == 1);
+}
+
+TEST_CASE("Snapshot concurrent updates are not lost", "[Snapshot]") {
+  Snapshot<int> snapshot{0};
+  auto threads = std::vector<std::thread>{};
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      auto reader = snapshot.reader();
+      for (int j = 0; j < 1000; ++j) {
+        snapshot.update([](int &value) { ++value; });
+        REQUIRE(reader.get() > 0);
+      }
+    });
+  }
+  for (auto &thread : threads) { thread.join(); }
+  REQUIRE(*snapshot.load() == 4000);
+}
@@ -0,0 +1,94 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include <mutex>
+#include <pf_common/parallel/AdaptiveMutex.h>
+#include <pf_common/parallel/Safe.h>
+#include <pf_common/parallel/SafeQueue.h>
+#include <pf_common/parallel/SpinMutex.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+namespace {
+template<typename Mutex>
+int lockedIncrements(int threadCount, int iterations) {
+  Mutex mutex;
+  auto counter = 0;
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&] {
+      for (auto j = 0; j < iterations; ++j) {
+        std::lock_guard lock{mutex};
+        ++counter;
+      }
+    });
+  }
+  for (auto &thread : threads) { thread.join(); }
+  return counter;
+}
+
+template<typename Mutex>
+bool tryLockWorks() {
+  Mutex mutex;
+  if (!mutex.try_lock() || mutex.try_lock()) { return false; }
+  mutex.unlock();
+  if (!mutex.try_lock()) { return false; }
+  mutex.unlock();
+  return true;
+}
+
+template<typename Mutex>
+std::size_t safeAppends(int threadCount, int iterations) {
+  Safe<std::vector<int>, Mutex> safe;
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&] {
+      for (auto j = 0; j < iterations; ++j) { safe->emplace_back(j); }
+    });
+  }
+  for (auto &thread : threads) { thread.join(); }
+  return safe.readOnlyAccess()->size();
+}
+
+template<typename Mutex>
+int queueSum(int count) {
+  SafeQueue<int, Mutex> queue;
+  auto sum = 0;
+  auto consumer = std::thread{[&] {
+    for (auto i = 0; i < count; ++i) { sum += queue.dequeue().value(); }
+  }};
+  for (auto i = 0; i < count; ++i) { queue.enqueue(int{i}); }
+  consumer.join();
+  return sum;
+}
+}// namespace
+
+TEST_CASE("SpinMutex provides mutual exclusion", "[SpinMutex]") {
+  REQUIRE(lockedIncrements<SpinMutex>(4, 10'000) == 40'000);
+  REQUIRE(tryLockWorks<SpinMutex>());
+}
+
+TEST_CASE("AdaptiveMutex provides mutual exclusion", "[AdaptiveMutex]") {
+  REQUIRE(lockedIncrements<AdaptiveMutex>(4, 10'000) == 40'000);
+  REQUIRE(tryLockWorks<AdaptiveMutex>());
+}
+
+TEST_CASE("Spinning mutexes work as Safe's Mutex", "[SpinMutex][AdaptiveMutex][Safe]") {
+  REQUIRE(safeAppends<SpinMutex>(4, 1000) == 4000);
+  REQUIRE(safeAppends<AdaptiveMutex>(4, 1000) == 4000);
+}
+
+TEST_CASE("Spinning mutexes work as SafeQueue's Mutex", "[SpinMutex][AdaptiveMutex][SafeQueue]") {
+  REQUIRE(queueSum<SpinMutex>(1000) == 499'500);
+  REQUIRE(queueSum<AdaptiveMutex>(1000) == 499'500);
+}
+
+TEST_CASE("ThreadPool accepts SafeQueue with defaulted Mutex", "[SafeQueue][ThreadPool]") {
+  ThreadPool pool{2};
+  REQUIRE(pool.enqueue([] { return 5; }).get() == 5);
+}
@@ -0,0 +1,99 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <pf_common/parallel/Task.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+namespace {
+Task<int> value(int result) { co_return result; }
+
+Task<int> valueOnPool(ThreadPool &pool, int result) {
+  co_await pool.schedule();
+  co_return result;
+}
+
+Task<std::thread::id> threadIdOnPool(ThreadPool &pool) {
+  co_await pool.schedule();
+  co_return std::this_thread::get_id();
+}
+
+Task<int> failing() {
+  throw std::runtime_error("error");
+  co_return 0;
+}
+
+Task<int> deepChain(int depth) {
+  if (depth == 0) { co_return 0; }
+  co_return co_await deepChain(depth - 1) + 1;
+}
+}// namespace
+
+TEST_CASE("Task is started lazily", "[Task]") {
+  auto started = false;
+  auto task = [](bool &started) -> Task<> {
+    started = true;
+    co_return;
+  }(started);
+  REQUIRE_FALSE(started);
+  syncWait(std::move(task));
+  REQUIRE(started);
+}
+
+TEST_CASE("Task returns values and propagates exceptions", "[Task]") {
+  REQUIRE(syncWait(value(42)) == 42);
+  REQUIRE_THROWS_AS(syncWait(failing()), std::runtime_error);
+}
+
+TEST_CASE("Task chain of awaiting tasks", "[Task]") { REQUIRE(syncWait(deepChain(1000)) == 1000); }
+
+TEST_CASE("Task schedule moves coroutine to the pool", "[Task][ThreadPool]") {
+  ThreadPool pool{2};
+  REQUIRE(syncWait(threadIdOnPool(pool)) != std::this_thread::get_id());
+  REQUIRE(syncWait(valueOnPool(pool, 3)) == 3);
+}
+
+TEST_CASE("whenAll waits for all tasks", "[Task][whenAll]") {
+  ThreadPool pool{4};
+  SECTION("variadic") {
+    auto voidTask = [](ThreadPool &pool) -> Task<> { co_await pool.schedule(); }(pool);
+    auto [first, second, third] = syncWait(whenAll(valueOnPool(pool, 1), value(2), std::move(voidTask)));
+    REQUIRE(first == 1);
+    REQUIRE(second == 2);
+    (void) third;
+  }
+  SECTION("vector") {
+    auto tasks = std::vector<Task<int>>{};
+    for (int i = 0; i < 100; ++i) { tasks.emplace_back(valueOnPool(pool, i)); }
+    const auto results = syncWait(whenAll(std::move(tasks)));
+    REQUIRE(results.size() == 100);
+    for (int i = 0; i < 100; ++i) { REQUIRE(results[i] == i); }
+  }
+  SECTION("exception") {
+    REQUIRE_THROWS_AS(syncWait(whenAll(valueOnPool(pool, 1), failing())), std::runtime_error);
+  }
+}
+
+TEST_CASE("whenAny returns the first finished task", "[Task][whenAny]") {
+  ThreadPool pool{2};
+  std::atomic<bool> release = false;
+  auto tasks = std::vector<Task<int>>{};
+  tasks.emplace_back([](ThreadPool &pool, std::atomic<bool> &release) -> Task<int> {
+    co_await pool.schedule();
+    while (!release) { std::this_thread::yield(); }
+    co_return 0;
+  }(pool, release));
+  tasks.emplace_back(value(1));
+  const auto result = syncWait(whenAny(std::move(tasks)));
+  REQUIRE(result.index == 1);
+  REQUIRE(result.value == 1);
+  release = true;
+}
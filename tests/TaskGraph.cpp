@@ -0,0 +1,102 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <pf_common/parallel/TaskGraph.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("TaskGraph respects dependencies", "[TaskGraph]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{4, mode};
+  TaskGraph graph{};
+  std::atomic<int> order = 0;
+  // diamond a -> (b, c) -> d
+  int a = -1, b = -1, c = -1, d = -1;
+  const auto nodeA = graph.addNode([&] { a = order++; });
+  const auto nodeB = graph.addNode([&] { b = order++; });
+  const auto nodeC = graph.addNode([&] { c = order++; });
+  const auto nodeD = graph.addNode([&] { d = order++; });
+  graph.addEdge(nodeA, nodeB);
+  graph.addEdge(nodeA, nodeC);
+  graph.addEdge(nodeB, nodeD);
+  graph.addEdge(nodeC, nodeD);
+  REQUIRE(graph.isAcyclic());
+
+  graph.runAndWait(pool);
+  REQUIRE(a == 0);
+  REQUIRE(b > a);
+  REQUIRE(c > a);
+  REQUIRE(d == 3);
+}
+
+TEST_CASE("TaskGraph can be run repeatedly", "[TaskGraph]") {
+  ThreadPool pool{4};
+  TaskGraph graph{};
+  std::atomic<int> counter = 0;
+  const auto root = graph.addNode([&] { ++counter; });
+  const auto sink = graph.addNode([&] { ++counter; });
+  for (int i = 0; i < 100; ++i) {
+    const auto node = graph.addNode([&] { ++counter; });
+    graph.addEdge(root, node);
+    graph.addEdge(node, sink);
+  }
+  for (int i = 1; i <= 10; ++i) {
+    graph.run(pool);
+    graph.wait();
+    REQUIRE(counter == i * 102);
+  }
+}
+
+TEST_CASE("TaskGraph can be run again once it's not running", "[TaskGraph]") {
+  // the thread finishing a run must not mark the next run finished
+  ThreadPool pool{2};
+  TaskGraph graph{};
+  std::atomic<int> counter = 0;
+  const auto first = graph.addNode([&] { ++counter; });
+  const auto second = graph.addNode([&] { ++counter; });
+  graph.addEdge(first, second);
+  for (int i = 1; i <= 1000; ++i) {
+    graph.run(pool);
+    while (graph.isRunning()) {}
+    REQUIRE(counter == 4 * i - 2);
+    graph.run(pool);
+    graph.wait();
+    REQUIRE(counter == 4 * i);
+  }
+}
+
+TEST_CASE("TaskGraph detects cycles", "[TaskGraph]") {
+  TaskGraph graph{};
+  const auto first = graph.addNode([] {});
+  const auto second = graph.addNode([] {});
+  graph.addEdge(first, second);
+  REQUIRE(graph.isAcyclic());
+  graph.addEdge(second, first);
+  REQUIRE_FALSE(graph.isAcyclic());
+}
+
+TEST_CASE("TaskGraph rethrows exception and skips remaining tasks", "[TaskGraph]") {
+  ThreadPool pool{2};
+  TaskGraph graph{};
+  auto ran = false;
+  const auto failing = graph.addNode([] { throw std::runtime_error("error"); });
+  const auto skipped = graph.addNode([&] { ran = true; });
+  graph.addEdge(failing, skipped);
+  graph.run(pool);
+  REQUIRE_THROWS_AS(graph.wait(), std::runtime_error);
+  REQUIRE_FALSE(ran);
+  REQUIRE_FALSE(graph.isRunning());
+}
+
+TEST_CASE("TaskGraph empty graph finishes immediately", "[TaskGraph]") {
+  ThreadPool pool{1};
+  TaskGraph graph{};
+  graph.runAndWait(pool);
+  REQUIRE(graph.getNodeCount() == 0);
+}
@@ -0,0 +1,318 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <array>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <pf_common/parallel/MPMCQueue.h>
+#include <pf_common/parallel/ThreadPool.h>
+#include <ranges>
+#include <vector>
+
+using namespace pf;
+
+TEST_CASE("ThreadPool runs enqueued tasks", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{4, mode};
+  REQUIRE(pool.getMode() == mode);
+  REQUIRE(pool.getThreadCount() == 4);
+
+  auto futures = std::vector<std::future<int>>{};
+  for (int i = 0; i < 100; ++i) {
+    futures.emplace_back(pool.enqueue([i] { return i * 2; }));
+  }
+  for (int i = 0; i < 100; ++i) { REQUIRE(futures[i].get() == i * 2); }
+}
+
+TEST_CASE("ThreadPool finishes tasks enqueued from other tasks before destruction", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool{3, mode};
+    for (int i = 0; i < 10; ++i) {
+      pool.enqueue([&] {
+        for (int j = 0; j < 10; ++j) {
+          pool.enqueue([&] { ++counter; });
+        }
+      });
+    }
+  }
+  REQUIRE(counter == 100);
+}
+
+TEST_CASE("ThreadPool propagates exceptions through future", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{2, mode};
+  auto future = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+  REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool cancelAndStop stops workers", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{2, mode};
+  pool.enqueue([] {}).wait();
+  pool.cancelAndStop();
+}
+
+TEST_CASE("Work stealing ThreadPool without threads gets one worker", "[ThreadPool]") {
+  ThreadPool pool{0, ThreadPoolMode::WorkStealing};
+  REQUIRE(pool.getThreadCount() == 1);
+  REQUIRE(pool.enqueue([] { return 1; }).get() == 1);
+}
+
+TEST_CASE("ThreadPool with MPMCQueue as backing queue", "[ThreadPool][MPMCQueue]") {
+  std::atomic<int> counter = 0;
+  {
+    BasicThreadPool<MPMCQueue> pool{4};
+    for (int i = 0; i < 5000; ++i) {
+      pool.enqueue([&] { ++counter; });
+    }
+  }
+  REQUIRE(counter == 5000);
+}
+
+TEST_CASE("ThreadPool worker runs nested task itself when bounded queue is full", "[ThreadPool][MPMCQueue]") {
+  // the only worker would wait for space in the queue forever, as it's the one supposed to empty it
+  std::atomic<int> counter = 0;
+  {
+    BasicThreadPool<MPMCQueue> pool{1};
+    pool.enqueue([&] {
+          for (std::size_t i = 0; i < MPMCQueue<int>::DEFAULT_CAPACITY * 3; ++i) {
+            pool.enqueue([&] { ++counter; });
+          }
+        })
+        .get();
+  }
+  REQUIRE(counter == MPMCQueue<int>::DEFAULT_CAPACITY * 3);
+}
+
+TEST_CASE("ThreadPool handles void results and large captures", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{2, mode};
+  int value = 0;
+  pool.enqueue([&value] { value = 1; }).get();
+  REQUIRE(value == 1);
+
+  auto data = std::vector<int>(100, 1);
+  auto array = std::array<int, 64>{};
+  array.fill(2);
+  auto future = pool.enqueue([data = std::move(data), array] { return std::accumulate(data.begin(), data.end(), 0) + array[0]; });
+  REQUIRE(future.get() == 102);
+}
+
+TEST_CASE("ThreadPool post runs tasks without futures", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool{3, mode};
+    for (int i = 0; i < 100; ++i) {
+      pool.post([&] { ++counter; });
+    }
+  }
+  REQUIRE(counter == 100);
+}
+
+TEST_CASE("ThreadPool bulk submission", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{3, mode};
+
+  SECTION("enqueueBulk returns futures in order") {
+    auto futures = pool.enqueueBulk(std::views::iota(0, 100) | std::views::transform([](int i) { return [i] { return i * 2; }; }));
+    REQUIRE(futures.size() == 100);
+    for (int i = 0; i < 100; ++i) { REQUIRE(futures[i].get() == i * 2); }
+  }
+  SECTION("postBulk from inside of a task") {
+    std::atomic<int> counter = 0;
+    auto callables = std::vector<std::function<void()>>(50, [&] { ++counter; });
+    pool.enqueue([&] { pool.postBulk(callables); }).wait();
+    pool.finishAndStop();
+    while (counter != 50) { std::this_thread::yield(); }
+    REQUIRE(counter == 50);
+  }
+}
+
+TEST_CASE("ThreadPool runs tasks by priority", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  auto order = std::vector<int>{};
+  {
+    ThreadPool pool{1, mode};
+    std::atomic<bool> blocked = true;
+    pool.post([&] {
+      while (blocked) { std::this_thread::yield(); }
+    });
+    pool.post(TaskPriority::Low, [&] { order.emplace_back(3); });
+    pool.post(TaskPriority::Normal, [&] { order.emplace_back(2); });
+    auto high = pool.enqueue(TaskPriority::High, [&] { order.emplace_back(1); });
+    blocked = false;
+    high.wait();
+  }
+  REQUIRE(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("ThreadPool doesn't starve lower priority tasks", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  auto order = std::vector<TaskPriority>{};
+  {
+    ThreadPool pool{1, mode};
+    std::atomic<bool> blocked = true;
+    pool.post([&] {
+      while (blocked) { std::this_thread::yield(); }
+    });
+    pool.post(TaskPriority::Low, [&] { order.emplace_back(TaskPriority::Low); });
+    for (std::size_t i = 0; i < 2 * details::PRIORITY_STARVATION_LIMIT; ++i) {
+      pool.post(TaskPriority::High, [&] { order.emplace_back(TaskPriority::High); });
+      pool.post([&] { order.emplace_back(TaskPriority::Normal); });
+    }
+    blocked = false;
+  }
+  REQUIRE(order.size() == 4 * details::PRIORITY_STARVATION_LIMIT + 1);
+  // a lower priority task gets its turn after PRIORITY_STARVATION_LIMIT High ones, Low isn't left for the very end
+  const auto firstNotHigh = std::ranges::find_if(order, [](auto priority) { return priority != TaskPriority::High; });
+  REQUIRE(firstNotHigh - order.begin() == static_cast<long>(details::PRIORITY_STARVATION_LIMIT));
+  REQUIRE(order.back() != TaskPriority::Low);
+}
+
+TEST_CASE("ThreadPool finishes prioritized tasks before stopping", "[ThreadPool]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool{3, mode};
+    for (int i = 0; i < 300; ++i) {
+      pool.post(static_cast<TaskPriority>(i % 3), [&] { ++counter; });
+    }
+  }
+  REQUIRE(counter == 300);
+}
+
+TEST_CASE("Elastic ThreadPool grows under load and shrinks when idle", "[ThreadPool]") {
+  using namespace std::chrono_literals;
+  ThreadPool pool{ElasticPoolConfig{.minThreads = 1, .maxThreads = 4, .idleTimeout = 20ms}};
+  REQUIRE(pool.getMode() == ThreadPoolMode::Elastic);
+  REQUIRE(pool.getThreadCount() == 1);
+  pool.enableStats();
+
+  std::atomic<bool> blocked = true;
+  std::atomic<int> running = 0;
+  auto futures = std::vector<std::future<void>>{};
+  for (int i = 0; i < 4; ++i) {
+    futures.emplace_back(pool.enqueue([&] {
+      ++running;
+      while (blocked) { std::this_thread::yield(); }
+    }));
+  }
+  // tasks block each other, they can only all run when the pool grew
+  while (running != 4) { std::this_thread::yield(); }
+  REQUIRE(pool.getThreadCount() == 4);
+  blocked = false;
+  for (auto &future : futures) { future.get(); }
+
+  while (pool.getThreadCount() != 1) { std::this_thread::sleep_for(5ms); }
+  REQUIRE(pool.enqueue([] { return 1; }).get() == 1);
+  REQUIRE(pool.getStats()->workers.size() == 4);
+  REQUIRE(pool.getStats()->tasksSubmitted == 5);
+}
+
+TEST_CASE("Elastic ThreadPool grows when tasks wait without new submissions", "[ThreadPool]") {
+  using namespace std::chrono_literals;
+  // queue depth never triggers growth here, only the time the queued task waits
+  ThreadPool pool{ElasticPoolConfig{.minThreads = 1, .maxThreads = 2, .growQueueDepth = 100, .maxWaitTime = 1ms}};
+  std::atomic<bool> blockerStarted = false;
+  std::atomic<bool> waitingTaskDone = false;
+  auto blocker = pool.enqueue([&] {
+    blockerStarted = true;
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!waitingTaskDone && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+  });
+  while (!blockerStarted) { std::this_thread::yield(); }
+  auto waiting = pool.enqueue([&] { waitingTaskDone = true; });
+  blocker.get();
+  REQUIRE(waitingTaskDone);
+  REQUIRE(pool.getThreadCount() == 2);
+  waiting.get();
+}
+
+TEST_CASE("Elastic ThreadPool without permanent workers", "[ThreadPool]") {
+  using namespace std::chrono_literals;
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool{ElasticPoolConfig{.minThreads = 0, .maxThreads = 2, .growQueueDepth = 8, .idleTimeout = 1ms}};
+    REQUIRE(pool.getThreadCount() == 0);
+    for (int i = 0; i < 100; ++i) {
+      pool.post([&] { ++counter; });
+      if (i % 10 == 0) { std::this_thread::sleep_for(2ms); }
+    }
+    pool.postBulk(std::vector<std::function<void()>>(100, [&] { ++counter; }));
+  }
+  REQUIRE(counter == 200);
+}
+
+TEST_CASE("Elastic ThreadPool with MPMCQueue and priorities", "[ThreadPool][MPMCQueue]") {
+  std::atomic<int> counter = 0;
+  {
+    BasicThreadPool<MPMCQueue> pool{ElasticPoolConfig{.minThreads = 0, .maxThreads = 3}};
+    for (int i = 0; i < 300; ++i) {
+      pool.post(static_cast<TaskPriority>(i % 3), [&] { ++counter; });
+    }
+  }
+  REQUIRE(counter == 300);
+}
+
+TEST_CASE("ThreadPool stats are disabled by default", "[ThreadPool]") {
+  ThreadPool pool{2};
+  pool.enqueue([] {}).wait();
+  REQUIRE_FALSE(pool.getStats().has_value());
+}
+
+TEST_CASE("ThreadPool collects stats", "[ThreadPool]") {
+  using namespace std::chrono_literals;
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{2, mode};
+  pool.enableStats();
+  std::atomic<bool> blocked = true;
+  pool.post([&] {
+    while (blocked) { std::this_thread::yield(); }
+  });
+  pool.post([&] {
+    while (blocked) { std::this_thread::yield(); }
+  });
+  auto futures = std::vector<std::future<void>>{};
+  for (int i = 0; i < 10; ++i) {
+    futures.emplace_back(pool.enqueue([] { std::this_thread::sleep_for(1ms); }));
+  }
+  REQUIRE(pool.getStats()->peakQueueDepth >= 10);
+  blocked = false;
+  for (auto &future : futures) { future.wait(); }
+  // statistics of the last task are recorded after its future is resolved
+  while (pool.getStats()->tasksExecuted != 12) { std::this_thread::yield(); }
+
+  const auto stats = *pool.getStats();
+  REQUIRE(stats.tasksSubmitted == 12);
+  REQUIRE(stats.queueDepth == 0);
+  REQUIRE(stats.executionTime.count == 12);
+  REQUIRE(stats.executionTime.percentile(0.5) >= 1ms);
+  REQUIRE(stats.waitTime.count == 12);
+  REQUIRE(stats.waitTime.max >= 1ms);
+  REQUIRE(stats.workers.size() == 2);
+  REQUIRE(stats.workers[0].tasksExecuted + stats.workers[1].tasksExecuted == 12);
+  REQUIRE(stats.workers[0].busyTime + stats.workers[0].idleTime <= stats.collectionTime + 1ms);
+}
+
+TEST_CASE("DurationHistogram percentiles", "[ThreadPool]") {
+  auto histogram = DurationHistogram{};
+  REQUIRE(histogram.percentile(0.5) == std::chrono::nanoseconds{0});
+  for (const auto duration : {std::chrono::nanoseconds{100}, std::chrono::nanoseconds{1000}, std::chrono::nanoseconds{100'000}}) {
+    ++histogram.buckets[DurationHistogram::bucketIndex(duration)];
+    ++histogram.count;
+    histogram.total += duration;
+    histogram.max = std::max(histogram.max, duration);
+  }
+  REQUIRE(histogram.percentile(0.3) == std::chrono::nanoseconds{128});
+  REQUIRE(histogram.percentile(0.6) == std::chrono::nanoseconds{1024});
+  REQUIRE(histogram.percentile(1.0) == std::chrono::nanoseconds{100'000});
+  REQUIRE(histogram.mean() == std::chrono::nanoseconds{33'700});
+}
@@ -0,0 +1,141 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <pf_common/parallel/ThreadPool.h>
+#include <pf_common/parallel/TimerWheel.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+using namespace std::chrono_literals;
+
+namespace {
+void waitFor(const auto &predicate, std::chrono::steady_clock::duration timeout = 10s) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!predicate() && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+}
+}// namespace
+
+TEST_CASE("TimerWheel runs a task after its delay", "[TimerWheel]") {
+  ThreadPool pool{2};
+  TimerWheel wheel{pool};
+  std::atomic<bool> ran = false;
+  std::atomic<std::chrono::steady_clock::time_point> ranAt{};
+  const auto start = std::chrono::steady_clock::now();
+  wheel.scheduleAfter(20ms, [&] {
+    ranAt = std::chrono::steady_clock::now();
+    ran = true;
+  });
+  REQUIRE(wheel.size() == 1);
+  waitFor([&] { return ran.load(); });
+  REQUIRE(ran);
+  REQUIRE(ranAt.load() - start >= 20ms);
+  REQUIRE(wheel.isEmpty());
+}
+
+TEST_CASE("TimerWheel runs tasks in order of deadlines", "[TimerWheel]") {
+  ThreadPool pool{1};
+  TimerWheel wheel{pool};
+  std::vector<int> order;
+  std::atomic<int> done = 0;
+  const auto now = std::chrono::steady_clock::now();
+  for (const auto delay : {30, 10, 20}) {
+    wheel.scheduleAt(now + std::chrono::milliseconds{delay}, [&, delay] {
+      order.emplace_back(delay);
+      ++done;
+    });
+  }
+  waitFor([&] { return done == 3; });
+  REQUIRE(order == std::vector{10, 20, 30});
+}
+
+TEST_CASE("TimerWheel cancelled task doesn't run", "[TimerWheel]") {
+  ThreadPool pool{1};
+  TimerWheel wheel{pool};
+  std::atomic<bool> cancelledRan = false;
+  std::atomic<bool> otherRan = false;
+  const auto handle = wheel.scheduleAfter(10ms, [&] { cancelledRan = true; });
+  wheel.scheduleAfter(30ms, [&] { otherRan = true; });
+  REQUIRE(wheel.cancel(handle));
+  REQUIRE_FALSE(wheel.cancel(handle));
+  waitFor([&] { return otherRan.load(); });
+  REQUIRE(otherRan);
+  REQUIRE_FALSE(cancelledRan);
+}
+
+TEST_CASE("TimerWheel handle of a fired timer can't cancel a reused timer", "[TimerWheel]") {
+  ThreadPool pool{1};
+  TimerWheel wheel{pool};
+  std::atomic<bool> ran = false;
+  const auto firstHandle = wheel.scheduleAfter(1ms, [] {});
+  waitFor([&] { return wheel.isEmpty(); });
+  const auto secondHandle = wheel.scheduleAfter(10ms, [&] { ran = true; });
+  REQUIRE(firstHandle.index == secondHandle.index);
+  REQUIRE_FALSE(wheel.cancel(firstHandle));
+  waitFor([&] { return ran.load(); });
+  REQUIRE(ran);
+}
+
+TEST_CASE("TimerWheel periodic task runs until cancelled", "[TimerWheel]") {
+  ThreadPool pool{2};
+  TimerWheel wheel{pool};
+  std::atomic<int> runCount = 0;
+  const auto handle = wheel.scheduleEvery(2ms, [&] { ++runCount; });
+  waitFor([&] { return runCount >= 5; });
+  REQUIRE(runCount >= 5);
+  REQUIRE(wheel.cancel(handle));
+  // a run posted right before cancellation might still be in the pool
+  std::this_thread::sleep_for(10ms);
+  const auto countAfterCancel = runCount.load();
+  std::this_thread::sleep_for(20ms);
+  REQUIRE(runCount == countAfterCancel);
+  REQUIRE(wheel.isEmpty());
+}
+
+TEST_CASE("TimerWheel deadlines in higher levels", "[TimerWheel]") {
+  ThreadPool pool{1};
+  // 10us ticks - 80ms is 8000 ticks, stored in level 1 and moved down to level 0
+  TimerWheel wheel{pool, 10us};
+  std::atomic<bool> ran = false;
+  const auto start = std::chrono::steady_clock::now();
+  wheel.scheduleAfter(80ms, [&] { ran = true; });
+  waitFor([&] { return ran.load(); });
+  REQUIRE(ran);
+  REQUIRE(std::chrono::steady_clock::now() - start >= 80ms);
+}
+
+TEST_CASE("TimerWheel many timers each run exactly once", "[TimerWheel]") {
+  constexpr static std::size_t TIMER_COUNT = 100'000;
+  ThreadPool pool{2};
+  TimerWheel wheel{pool, 100us};
+  auto runCounts = std::vector<std::atomic<int>>(TIMER_COUNT);
+  std::atomic<std::size_t> totalRunCount = 0;
+  auto handles = std::vector<TimerHandle>{};
+  handles.reserve(TIMER_COUNT);
+  auto random = std::mt19937{42};
+  auto delay = std::uniform_int_distribution<int>{0, 50'000};
+  for (std::size_t i = 0; i < TIMER_COUNT; ++i) {
+    handles.emplace_back(wheel.scheduleAfter(std::chrono::microseconds{delay(random)}, [&, i] {
+      ++runCounts[i];
+      ++totalRunCount;
+    }));
+  }
+  std::size_t cancelledCount = 0;
+  auto isCancelled = std::vector<bool>(TIMER_COUNT);
+  for (std::size_t i = 0; i < TIMER_COUNT; i += 3) {
+    if (wheel.cancel(handles[i])) {
+      isCancelled[i] = true;
+      ++cancelledCount;
+    }
+  }
+  REQUIRE(cancelledCount > 0);
+  waitFor([&] { return totalRunCount == TIMER_COUNT - cancelledCount; });
+  REQUIRE(wheel.isEmpty());
+  for (std::size_t i = 0; i < TIMER_COUNT; ++i) { REQUIRE(runCounts[i] == (isCancelled[i] ? 0 : 1)); }
+}
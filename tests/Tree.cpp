@@ -0,0 +1,190 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <pf_common/containers/Tree.h>
+#include <utility>
+#include <vector>
+
+#include "TreeTestUtils.h"
+
+using namespace pf;
+
+TEST_CASE("Tree iteration", "[Tree]") {
+  auto tree = makeTree<Tree<int>>();
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+  REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 1, 2, 3, 4, 5, 6});
+
+  SECTION("subtree") {
+    auto &node1 = *tree.getRoot().children().begin();
+    REQUIRE(collect(node1.iterDepthFirst()) == std::vector{1, 4, 5});
+    REQUIRE(collect(node1.iterBreadthFirst()) == std::vector{1, 4, 5});
+    auto &node2 = *std::next(tree.getRoot().children().begin());
+    REQUIRE(collect(node2.iterDepthFirst()) == std::vector{2});
+    REQUIRE(collect(node2.iterBreadthFirst()) == std::vector{2});
+  }
+  SECTION("const and nodes") {
+    const auto &constTree = tree;
+    REQUIRE(collect(constTree.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+    auto childCounts = std::vector<std::size_t>{};
+    for (const auto &node : constTree.iterNodesBreadthFirst()) { childCounts.emplace_back(node.childrenSize()); }
+    REQUIRE(childCounts == std::vector<std::size_t>{3, 2, 0, 1, 0, 0, 0});
+  }
+  SECTION("post increment returns an independent copy") {
+    auto iteration = tree.iterBreadthFirst();
+    auto iter = iteration.begin();
+    ++iter;
+    const auto copy = iter++;
+    REQUIRE(*copy == 1);
+    REQUIRE(*iter == 2);
+    REQUIRE(collect(std::ranges::subrange(copy, iteration.end())) == std::vector{1, 2, 3, 4, 5, 6});
+  }
+  SECTION("modification through iteration") {
+    for (auto &value : tree.iterDepthFirst()) { value *= 10; }
+    REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 10, 20, 30, 40, 50, 60});
+  }
+}
+
+TEST_CASE("Tree iteration follows child modifications", "[Tree]") {
+  auto tree = makeTree<Tree<int>>();
+  auto &root = tree.getRoot();
+  root.insertChild(1, 7);
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 1, 4, 5, 7, 2, 3, 6});
+
+  auto removed = root.removeChild(0);
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 7, 2, 3, 6});
+  REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 7, 2, 3, 6});
+  REQUIRE(collect(removed->iterDepthFirst()) == std::vector{1, 4, 5});
+
+  (*std::next(root.children().begin())).appendChild(std::move(removed));
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 7, 2, 1, 4, 5, 3, 6});
+
+  root.sortChildren([](int lhs, int rhs) { return lhs > rhs; });
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0, 7, 3, 6, 2, 1, 4, 5});
+  REQUIRE(collect(tree.iterBreadthFirst()) == std::vector{0, 7, 3, 2, 6, 1, 4, 5});
+
+  auto children = root.clearChildren();
+  REQUIRE(collect(tree.iterDepthFirst()) == std::vector{0});
+  REQUIRE(collect(children.back()->iterDepthFirst()) == std::vector{2, 1, 4, 5});
+}
+
+TEST_CASE("Tree moved node keeps its children", "[Tree]") {
+  auto tree = makeTree<Tree<int>>();
+  auto moved = std::move(tree.getRoot());
+  REQUIRE(collect(moved.iterDepthFirst()) == std::vector{0, 1, 4, 5, 2, 3, 6});
+  REQUIRE(collect(moved.iterBreadthFirst()) == std::vector{0, 1, 2, 3, 4, 5, 6});
+}
+
+TEST_CASE("Tree iteration of large trees", "[Tree]") {
+  constexpr static int NODE_COUNT = 10'000;
+  const auto check = [](const auto &parentOf) {
+    auto tree = Tree<int>{0};
+    auto nodes = std::vector<Node<int> *>{&tree.getRoot()};
+    for (int i = 1; i < NODE_COUNT; ++i) { nodes.emplace_back(&nodes[static_cast<std::size_t>(parentOf(i))]->appendChild(i)); }
+    auto expected = std::vector<int>{};
+    const auto preorder = [&](const auto &self, const Node<int> &node) -> void {
+      expected.emplace_back(*node);
+      for (const auto &child : node.children()) { self(self, child); }
+    };
+    preorder(preorder, tree.getRoot());
+    REQUIRE(collect(tree.iterDepthFirst()) == expected);
+    auto visited = std::vector<int>{};
+    tree_traversal::cDepthFirst(tree, [&](const Node<int> &node) { visited.emplace_back(*node); });
+    REQUIRE(visited == expected);
+    // every parent has its children appended in order, so breadth first order is the order of creation
+    const auto breadthFirst = collect(tree.iterBreadthFirst());
+    REQUIRE(breadthFirst.size() == NODE_COUNT);
+    REQUIRE(std::ranges::is_sorted(breadthFirst));
+    visited.clear();
+    tree_traversal::cBreadthFirst(tree, [&](const Node<int> &node) { visited.emplace_back(*node); });
+    REQUIRE(visited == breadthFirst);
+  };
+  SECTION("wide") {
+    check([](int i) { return i / 3; });
+  }
+  SECTION("deep with siblings along the path") {
+    check([](int i) { return std::max(0, i - 1 - i % 4); });
+  }
+}
+
+TEST_CASE("Tree depth first traversal with hooks", "[Tree]") {
+  auto tree = makeTree<Tree<int>>();
+  auto preOrder = std::vector<int>{};
+  auto postOrder = std::vector<int>{};
+  REQUIRE(tree_traversal::depthFirst(
+      tree, [&](Node<int> &node) { preOrder.emplace_back(*node); }, [&](Node<int> &node) { postOrder.emplace_back(*node); }));
+  REQUIRE(preOrder == std::vector{0, 1, 4, 5, 2, 3, 6});
+  REQUIRE(postOrder == std::vector{4, 5, 1, 2, 6, 3, 0});
+
+  SECTION("skip subtree") {
+    preOrder.clear();
+    postOrder.clear();
+    REQUIRE(tree_traversal::cDepthFirst(
+        std::as_const(tree),
+        [&](const Node<int> &node) {
+          preOrder.emplace_back(*node);
+          return *node == 1 ? tree_traversal::Action::SkipSubtree : tree_traversal::Action::Continue;
+        },
+        [&](const Node<int> &node) { postOrder.emplace_back(*node); }));
+    REQUIRE(preOrder == std::vector{0, 1, 2, 3, 6});
+    REQUIRE(postOrder == std::vector{1, 2, 6, 3, 0});
+  }
+  SECTION("stop") {
+    preOrder.clear();
+    const auto finished = tree_traversal::depthFirst(tree, [&](Node<int> &node) {
+      preOrder.emplace_back(*node);
+      return *node == 5 ? tree_traversal::Action::Stop : tree_traversal::Action::Continue;
+    });
+    REQUIRE_FALSE(finished);
+    REQUIRE(preOrder == std::vector{0, 1, 4, 5});
+  }
+  SECTION("subtree") {
+    preOrder.clear();
+    tree_traversal::depthFirst(*tree.getRoot().children().begin(), [&](Node<int> &node) { preOrder.emplace_back(*node); });
+    REQUIRE(preOrder == std::vector{1, 4, 5});
+  }
+  SECTION("results other than Action are ignored") {
+    auto sum = 0;
+    REQUIRE(tree_traversal::depthFirst(tree, [&](auto &node) { return sum += *node; }));
+    REQUIRE(sum == 21);
+    REQUIRE(tree_traversal::breadthFirst(tree, [](Node<int> &) { return false; }));
+  }
+}
+
+TEST_CASE("Tree breadth first traversal with pruning", "[Tree]") {
+  auto tree = makeTree<Tree<int>>();
+  auto visited = std::vector<int>{};
+  REQUIRE(tree_traversal::cBreadthFirst(std::as_const(tree), [&](const Node<int> &node) {
+    visited.emplace_back(*node);
+    return *node == 1 ? tree_traversal::Action::SkipSubtree : tree_traversal::Action::Continue;
+  }));
+  REQUIRE(visited == std::vector{0, 1, 2, 3, 6});
+
+  visited.clear();
+  REQUIRE_FALSE(tree_traversal::breadthFirst(tree, [&](Node<int> &node) {
+    visited.emplace_back(*node);
+    return *node == 3 ? tree_traversal::Action::Stop : tree_traversal::Action::Continue;
+  }));
+  REQUIRE(visited == std::vector{0, 1, 2, 3});
+}
+
+TEST_CASE("Tree depth first traversal of a very deep tree", "[Tree]") {
+  constexpr static int DEPTH = 1'000'000;
+  auto tree = Tree<int>{0};
+  auto node = &tree.getRoot();
+  for (int i = 1; i < DEPTH; ++i) { node = &node->appendChild(i); }
+  std::size_t visitedCount = 0;
+  int lastPostOrder = -1;
+  tree_traversal::cDepthFirst(
+      std::as_const(tree), [&](const Node<int> &) { ++visitedCount; }, [&](const Node<int> &node) { lastPostOrder = *node; });
+  REQUIRE(visitedCount == DEPTH);
+  REQUIRE(lastPostOrder == 0);
+  // destroying the chain recursively would overflow the stack as well
+  while (tree.getRoot().childrenSize() != 0) {
+    auto child = tree.getRoot().removeChild(0);
+    if (child->childrenSize() != 0) { tree.getRoot().appendChild(child->removeChild(0)); }
+  }
+}
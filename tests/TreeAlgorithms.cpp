@@ -0,0 +1,174 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <pf_common/parallel/TreeAlgorithms.h>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace pf;
+
+namespace {
+/**
+ * Random tree where node values are indices in order of creation.
+ */
+Tree<std::size_t> makeRandomTree(std::size_t nodeCount, unsigned seed) {
+  auto tree = Tree<std::size_t>{std::size_t{0}};
+  auto nodes = std::vector<Node<std::size_t> *>{&tree.getRoot()};
+  auto random = std::mt19937{seed};
+  for (std::size_t i = 1; i < nodeCount; ++i) {
+    // prefer recently added nodes so the tree gets deep as well as wide
+    auto parentIndex = std::uniform_int_distribution<std::size_t>{nodes.size() > 16 ? nodes.size() - 16 : 0, nodes.size() - 1};
+    nodes.emplace_back(&nodes[parentIndex(random)]->appendChild(i));
+  }
+  return tree;
+}
+
+std::size_t serialSubtreeSizes(const Node<std::size_t> &node, std::vector<std::size_t> &sizes) {
+  auto size = std::size_t{1};
+  for (const auto &child : node.children()) { size += serialSubtreeSizes(child, sizes); }
+  sizes[*node] = size;
+  return size;
+}
+}// namespace
+
+TEST_CASE("parallelDepthFirst visits every node once, parents before children", "[parallel][TreeAlgorithms]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  const auto grainSize = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{16});
+  ThreadPool pool{4, mode};
+  constexpr static std::size_t NODE_COUNT = 20'000;
+  auto tree = makeRandomTree(NODE_COUNT, 1);
+  auto visitOrder = std::vector<std::size_t>(NODE_COUNT, NODE_COUNT);
+  std::atomic<std::size_t> counter = 0;
+  parallelDepthFirst(pool, tree, [&](Node<std::size_t> &node) { visitOrder[*node] = counter++; }, grainSize);
+  REQUIRE(counter == NODE_COUNT);
+  tree_traversal::depthFirst(tree, [&](Node<std::size_t> &node) {
+    for (const auto &child : node.children()) { REQUIRE(visitOrder[*node] < visitOrder[*child]); }
+  });
+}
+
+TEST_CASE("parallelDepthFirst with const tree and empty tree", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{2};
+  const auto tree = makeRandomTree(1000, 2);
+  std::atomic<std::size_t> sum = 0;
+  parallelDepthFirst(pool, tree, [&](const Node<std::size_t> &node) { sum += *node; });
+  REQUIRE(sum == 999 * 1000 / 2);
+
+  const auto emptyTree = Tree<std::size_t>{};
+  parallelDepthFirst(pool, emptyTree, [&](const Node<std::size_t> &) { ++sum; });
+  REQUIRE(sum == 999 * 1000 / 2);
+}
+
+TEST_CASE("parallelDepthFirst rethrows exceptions", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{4};
+  auto tree = makeRandomTree(5000, 3);
+  REQUIRE_THROWS_AS(parallelDepthFirst(
+                        pool, tree,
+                        [](Node<std::size_t> &node) {
+                          if (*node == 4000) { throw std::runtime_error{"fail"}; }
+                        },
+                        1),
+                    std::runtime_error);
+}
+
+TEST_CASE("parallelDepthFirst can be nested in pool's tasks", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{2};
+  auto tree = makeRandomTree(5000, 4);
+  auto future = pool.enqueue([&] {
+    std::atomic<std::size_t> count = 0;
+    parallelDepthFirst(pool, tree, [&](Node<std::size_t> &) { ++count; }, 8);
+    return count.load();
+  });
+  REQUIRE(future.get() == 5000);
+}
+
+TEST_CASE("parallelDepthFirst doesn't hold pool's workers while it has no work for them", "[parallel][TreeAlgorithms]") {
+  using namespace std::chrono_literals;
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  ThreadPool pool{2, mode};
+  // a chain has nothing to share, the traversal stays serial
+  auto tree = Tree<std::size_t>{std::size_t{0}};
+  auto last = &tree.getRoot();
+  for (std::size_t i = 1; i < 2000; ++i) { last = &last->appendChild(i); }
+  std::atomic<bool> otherTaskDone = false;
+  auto otherTaskDoneInTime = false;
+  parallelDepthFirst(
+      pool, tree,
+      [&](Node<std::size_t> &node) {
+        if (*node != 1000) { return; }
+        pool.enqueue([&] { otherTaskDone = true; });
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (!otherTaskDone && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(1ms); }
+        otherTaskDoneInTime = otherTaskDone;
+      },
+      1);
+  REQUIRE(otherTaskDoneInTime);
+}
+
+TEST_CASE("parallelFoldPostOrder computes subtree sizes", "[parallel][TreeAlgorithms]") {
+  const auto mode = GENERATE(ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing);
+  const auto grainSize = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{16});
+  ThreadPool pool{4, mode};
+  constexpr static std::size_t NODE_COUNT = 20'000;
+  const auto tree = makeRandomTree(NODE_COUNT, 5);
+  auto expectedSizes = std::vector<std::size_t>(NODE_COUNT);
+  serialSubtreeSizes(tree.getRoot(), expectedSizes);
+
+  auto sizes = std::vector<std::size_t>(NODE_COUNT);
+  const auto size = parallelFoldPostOrder<std::size_t>(
+      pool, tree,
+      [&](const Node<std::size_t> &node, std::span<std::size_t> children) {
+        const auto result = std::accumulate(children.begin(), children.end(), std::size_t{1});
+        sizes[*node] = result;
+        return result;
+      },
+      grainSize);
+  REQUIRE(size == NODE_COUNT);
+  REQUIRE(sizes == expectedSizes);
+}
+
+TEST_CASE("parallelFoldPostOrder passes child results in order", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{4};
+  const auto tree = makeRandomTree(3000, 6);
+  // values of the subtree in preorder, results of children are concatenated in order of the children
+  const auto preorder = parallelFoldPostOrder<std::vector<std::size_t>>(
+      pool, tree,
+      [](const Node<std::size_t> &node, std::span<std::vector<std::size_t>> children) {
+        auto result = std::vector<std::size_t>{*node};
+        for (auto &child : children) { result.insert(result.end(), child.begin(), child.end()); }
+        return result;
+      },
+      1);
+  auto expected = std::vector<std::size_t>{};
+  tree_traversal::cDepthFirst(tree.getRoot(), [&](const Node<std::size_t> &node) { expected.emplace_back(*node); });
+  REQUIRE(preorder == expected);
+}
+
+TEST_CASE("parallelFoldPostOrder on empty tree and single node", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{2};
+  const auto count = [](const Node<int> &, std::span<int> children) { return std::accumulate(children.begin(), children.end(), 1); };
+  REQUIRE(parallelFoldPostOrder<int>(pool, Tree<int>{}, count) == 0);
+  REQUIRE(parallelFoldPostOrder<int>(pool, Tree<int>{1}, count) == 1);
+}
+
+TEST_CASE("parallelFoldPostOrder rethrows exceptions", "[parallel][TreeAlgorithms]") {
+  ThreadPool pool{4};
+  auto tree = makeRandomTree(5000, 7);
+  REQUIRE_THROWS_AS(parallelFoldPostOrder<int>(
+                        pool, tree,
+                        [](Node<std::size_t> &node, std::span<int>) -> int {
+                          if (*node == 10) { throw std::runtime_error{"fail"}; }
+                          return 0;
+                        },
+                        1),
+                    std::runtime_error);
+}
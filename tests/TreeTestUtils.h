@@ -0,0 +1,41 @@
+//
+// Created by Petr on 17.10.2026.
+//
+
+#ifndef PF_COMMON_TESTS_TREETESTUTILS_H
+#define PF_COMMON_TESTS_TREETESTUTILS_H
+
+#include <vector>
+
+/**
+ *        0
+ *      / | \
+ *     1  2  3
+ *    / \     \
+ *   4   5     6
+ * @tparam TreeType tree with int values, e.g. pf::Tree<int> or pf::ArenaTree<int>
+ */
+template<typename TreeType>
+TreeType makeTree() {
+  auto tree = TreeType{0};
+  auto &root = tree.getRoot();
+  auto &node1 = root.appendChild(1);
+  root.appendChild(2);
+  auto &node3 = root.appendChild(3);
+  node1.appendChild(4);
+  node1.appendChild(5);
+  node3.appendChild(6);
+  return tree;
+}
+
+/**
+ * @return values of the range in order of iteration
+ */
+template<typename R>
+std::vector<int> collect(R &&range) {
+  auto result = std::vector<int>{};
+  for (const auto &value : range) { result.emplace_back(value); }
+  return result;
+}
+
+#endif//PF_COMMON_TESTS_TREETESTUTILS_H